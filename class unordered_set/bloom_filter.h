@@ -0,0 +1,273 @@
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "hash.h"
+#include "table_policy.h"
+
+// Проверка блока с AVX2: включается при запуске, если процессор поддерживает AVX2.
+// Определите BLOOM_FILTER_SIMD 0, чтобы всегда проверять по одному слову
+#ifndef BLOOM_FILTER_SIMD
+#if defined(__x86_64__) || defined(__i386__)
+#define BLOOM_FILTER_SIMD 1
+#else
+#define BLOOM_FILTER_SIMD 0
+#endif
+#endif
+
+// Блочный фильтр Блума: ключ попадает в один блок размером со строку кэша и ставит по одному биту
+// в каждом из восьми его 64-битных слов. Блок выбирается старшими 32 битами хэша, номера битов -
+// произведениями младших 32 бит на восемь нечетных констант, поэтому проверка читает одну строку кэша,
+// а с AVX2 укладывается в несколько инструкций. Хэш берется тот же, что у множества
+namespace bloom_filter_detail {
+constexpr size_t kBlockWords = 8;
+constexpr size_t kBlockBits = 64 * kBlockWords;
+
+struct alignas(64) Block {
+  uint64_t words[kBlockWords];
+};
+
+alignas(32) constexpr uint32_t kSalts[kBlockWords] = {0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du,
+                                                       0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u};
+
+inline uint64_t BitOf(uint32_t key, size_t word) {
+  return uint64_t{1} << ((key * kSalts[word]) >> 26);
+}
+
+inline void SetBits(Block& block, uint32_t key) {
+  for (size_t i = 0; i < kBlockWords; ++i) {
+    block.words[i] |= BitOf(key, i);
+  }
+}
+
+inline bool HasBits(const Block& block, uint32_t key) {
+  for (size_t i = 0; i < kBlockWords; ++i) {
+    if ((block.words[i] & BitOf(key, i)) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if BLOOM_FILTER_SIMD
+// Маска ключа для двух половин блока; функции компилируются под AVX2 и вызываются только после проверки процессора
+struct Mask {
+  __m256i low;
+  __m256i high;
+};
+
+__attribute__((target("avx2"))) inline Mask MakeMask(uint32_t key) {
+  __m256i products = _mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(key)),
+                                        _mm256_load_si256(reinterpret_cast<const __m256i*>(kSalts)));
+  __m256i shifts = _mm256_srli_epi32(products, 26);
+  __m256i ones = _mm256_set1_epi64x(1);
+  return {_mm256_sllv_epi64(ones, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts))),
+          _mm256_sllv_epi64(ones, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1)))};
+}
+
+__attribute__((target("avx2"))) inline void SetBitsWide(Block& block, uint32_t key) {
+  Mask mask = MakeMask(key);
+  auto* words = reinterpret_cast<__m256i*>(block.words);
+  _mm256_store_si256(words, _mm256_or_si256(_mm256_load_si256(words), mask.low));
+  _mm256_store_si256(words + 1, _mm256_or_si256(_mm256_load_si256(words + 1), mask.high));
+}
+
+// testc дает 1, если все биты маски есть в блоке
+__attribute__((target("avx2"))) inline bool HasBitsWide(const Block& block, uint32_t key) {
+  Mask mask = MakeMask(key);
+  const auto* words = reinterpret_cast<const __m256i*>(block.words);
+  return _mm256_testc_si256(_mm256_load_si256(words), mask.low) &
+         _mm256_testc_si256(_mm256_load_si256(words + 1), mask.high);
+}
+
+inline bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+#endif
+}  // namespace bloom_filter_detail
+
+template <class KeyT, class Hash = DefaultHash<KeyT>>
+class BloomFilter {
+  template <class K>
+  using EnableIfTransparent = std::enable_if_t<IsTransparent<Hash>::value && !std::is_same_v<K, KeyT>>;
+
+ public:
+  BloomFilter() = default;
+  // Место под capacity ключей по bits_per_key бит: при 8 битах ложных срабатываний около 3%,
+  // при 10 - около 1%, при 16 - около 0.1%. Сверх capacity доля ложных срабатываний быстро растет
+  explicit BloomFilter(size_t capacity, size_t bits_per_key = 10);
+
+  BloomFilter(const BloomFilter&) = default;
+  BloomFilter(BloomFilter&&) noexcept;
+
+  BloomFilter& operator=(const BloomFilter&) = default;
+  BloomFilter& operator=(BloomFilter&&) noexcept;
+
+  void Insert(const KeyT&);
+  template <class K, class = EnableIfTransparent<K>>
+  void Insert(const K&);
+  // false - ключа точно нет, true - ключ, возможно, есть
+  bool MayContain(const KeyT&) const;
+  template <class K, class = EnableIfTransparent<K>>
+  bool MayContain(const K&) const;
+
+  // Хэш, по которому фильтр ставит и проверяет биты
+  uint64_t HashOf(const KeyT&) const;
+  template <class K, class = EnableIfTransparent<K>>
+  uint64_t HashOf(const K&) const;
+
+  // То же по готовому хэшу, чтобы не считать его второй раз
+  void InsertHash(uint64_t hash);
+  bool MayContainHash(uint64_t hash) const;
+  void Prefetch(uint64_t hash) const;
+
+  // Сбрасывает все биты, размер фильтра не меняется
+  void Clear();
+
+  size_t Capacity() const;
+  size_t BlockCount() const;
+  size_t SizeInBytes() const;
+
+ private:
+  const bloom_filter_detail::Block& BlockOf(uint64_t hash) const;
+  bloom_filter_detail::Block& BlockOf(uint64_t hash);
+
+  std::vector<bloom_filter_detail::Block> blocks_;
+  size_t capacity_ = 0;
+  Hash hash_ = {};
+};
+
+// Конструкторы
+template <class KeyT, class Hash>
+BloomFilter<KeyT, Hash>::BloomFilter(size_t capacity, size_t bits_per_key)
+    : blocks_(std::max<size_t>(1, (capacity * bits_per_key + bloom_filter_detail::kBlockBits - 1) /
+                                      bloom_filter_detail::kBlockBits),
+              bloom_filter_detail::Block{}),
+      capacity_(capacity) {
+}
+
+template <class KeyT, class Hash>
+BloomFilter<KeyT, Hash>::BloomFilter(BloomFilter&& other) noexcept
+    : blocks_(std::move(other.blocks_)), capacity_(std::exchange(other.capacity_, 0)), hash_(other.hash_) {
+  other.blocks_.clear();
+}
+
+// Присваивание
+template <class KeyT, class Hash>
+BloomFilter<KeyT, Hash>& BloomFilter<KeyT, Hash>::operator=(BloomFilter&& other) noexcept {
+  if (this != &other) {
+    blocks_ = std::move(other.blocks_);
+    other.blocks_.clear();
+    capacity_ = std::exchange(other.capacity_, 0);
+    hash_ = other.hash_;
+  }
+  return *this;
+}
+
+// Методы
+template <class KeyT, class Hash>
+const bloom_filter_detail::Block& BloomFilter<KeyT, Hash>::BlockOf(uint64_t hash) const {
+  return blocks_[static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32)];
+}
+
+template <class KeyT, class Hash>
+bloom_filter_detail::Block& BloomFilter<KeyT, Hash>::BlockOf(uint64_t hash) {
+  return blocks_[static_cast<size_t>(((hash >> 32) * blocks_.size()) >> 32)];
+}
+
+template <class KeyT, class Hash>
+void BloomFilter<KeyT, Hash>::InsertHash(uint64_t hash) {
+  bloom_filter_detail::Block& block = BlockOf(hash);
+#if BLOOM_FILTER_SIMD
+  if (bloom_filter_detail::HasAvx2()) {
+    bloom_filter_detail::SetBitsWide(block, static_cast<uint32_t>(hash));
+    return;
+  }
+#endif
+  bloom_filter_detail::SetBits(block, static_cast<uint32_t>(hash));
+}
+
+template <class KeyT, class Hash>
+bool BloomFilter<KeyT, Hash>::MayContainHash(uint64_t hash) const {
+  if (blocks_.empty()) {
+    return false;
+  }
+  const bloom_filter_detail::Block& block = BlockOf(hash);
+#if BLOOM_FILTER_SIMD
+  if (bloom_filter_detail::HasAvx2()) {
+    return bloom_filter_detail::HasBitsWide(block, static_cast<uint32_t>(hash));
+  }
+#endif
+  return bloom_filter_detail::HasBits(block, static_cast<uint32_t>(hash));
+}
+
+template <class KeyT, class Hash>
+void BloomFilter<KeyT, Hash>::Prefetch(uint64_t hash) const {
+  if (!blocks_.empty()) {
+    __builtin_prefetch(&BlockOf(hash));
+  }
+}
+
+template <class KeyT, class Hash>
+uint64_t BloomFilter<KeyT, Hash>::HashOf(const KeyT& key) const {
+  return hash_(key);
+}
+
+template <class KeyT, class Hash>
+template <class K, class>
+uint64_t BloomFilter<KeyT, Hash>::HashOf(const K& key) const {
+  return hash_(key);
+}
+
+template <class KeyT, class Hash>
+void BloomFilter<KeyT, Hash>::Insert(const KeyT& key) {
+  InsertHash(HashOf(key));
+}
+
+template <class KeyT, class Hash>
+template <class K, class>
+void BloomFilter<KeyT, Hash>::Insert(const K& key) {
+  InsertHash(HashOf(key));
+}
+
+template <class KeyT, class Hash>
+bool BloomFilter<KeyT, Hash>::MayContain(const KeyT& key) const {
+  return MayContainHash(HashOf(key));
+}
+
+template <class KeyT, class Hash>
+template <class K, class>
+bool BloomFilter<KeyT, Hash>::MayContain(const K& key) const {
+  return MayContainHash(HashOf(key));
+}
+
+template <class KeyT, class Hash>
+void BloomFilter<KeyT, Hash>::Clear() {
+  std::fill(blocks_.begin(), blocks_.end(), bloom_filter_detail::Block{});
+}
+
+template <class KeyT, class Hash>
+size_t BloomFilter<KeyT, Hash>::Capacity() const {
+  return capacity_;
+}
+
+template <class KeyT, class Hash>
+size_t BloomFilter<KeyT, Hash>::BlockCount() const {
+  return blocks_.size();
+}
+
+template <class KeyT, class Hash>
+size_t BloomFilter<KeyT, Hash>::SizeInBytes() const {
+  return blocks_.size() * sizeof(bloom_filter_detail::Block);
+}
+#endif  // BLOOM_FILTER_H
@@ -0,0 +1,680 @@
+#ifndef CHAINED_TABLE_H
+#define CHAINED_TABLE_H
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "hash.h"
+#include "table_policy.h"
+#include "table_stats.h"
+
+// Таблица с цепочками: каждая корзина - отдельный список, каждое значение - отдельный узел в куче.
+// Число корзин - степень двойки, корзина выбирается фибоначчиевым умножением, а не остатком от деления.
+// При kIncremental рост не перестраивает таблицу за один вызов: старая и новая таблицы живут вместе,
+// каждая вставка и удаление переносят не больше kMigrateBuckets старых корзин, а поиск смотрит в обе.
+// Перенос перекладывает узлы в другие корзины, поэтому, пока он не закончен, вставка нового ключа,
+// удаление и Extract делают недействительными все итераторы, как рост таблицы. Поиск, вставка
+// уже имеющегося ключа и удаление отсутствующего ничего не переносят и итераторы не трогают
+template <class Policy, class Hash = DefaultHash<typename Policy::Key>,
+          class KeyEqual = DefaultKeyEqual<typename Policy::Key>, bool kIncremental = false>
+class ChainedTable {
+ public:
+  using KeyT = typename Policy::Key;
+  using ValueT = typename Policy::Value;
+
+ private:
+  using List = std::list<ValueT>;
+
+ public:
+  // Прямой итератор: обходит корзины новой таблицы по порядку, затем еще не перенесенные корзины старой.
+  // Узлы не перемещаются, но после перестроения таблицы итератор недействителен
+  template <bool kIsConst>
+  class BasicIterator {
+    using Owner = std::conditional_t<kIsConst, const ChainedTable, ChainedTable>;
+    using ListIterator = std::conditional_t<kIsConst, typename List::const_iterator, typename List::iterator>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;  // NOLINT
+    using difference_type = std::ptrdiff_t;  // NOLINT
+    using value_type = ValueT;  // NOLINT
+    using reference = std::conditional_t<kIsConst, const ValueT&, ValueT&>;  // NOLINT
+    using pointer = std::conditional_t<kIsConst, const ValueT*, ValueT*>;  // NOLINT
+
+    BasicIterator() = default;
+    template <bool kOtherConst, class = std::enable_if_t<kIsConst && !kOtherConst>>
+    BasicIterator(const BasicIterator<kOtherConst>& other)  // NOLINT
+        : table_(other.table_), bucket_(other.bucket_), it_(other.it_) {
+    }
+
+    reference operator*() const {
+      return *it_;
+    }
+    pointer operator->() const {
+      return &*it_;
+    }
+    BasicIterator& operator++() {
+      ++it_;
+      SkipEmpty();
+      return *this;
+    }
+    BasicIterator operator++(int) {
+      BasicIterator helper = *this;
+      ++(*this);
+      return helper;
+    }
+    friend bool operator==(const BasicIterator& first, const BasicIterator& second) {
+      return first.bucket_ == second.bucket_ && first.it_ == second.it_;
+    }
+    friend bool operator!=(const BasicIterator& first, const BasicIterator& second) {
+      return !(first == second);
+    }
+
+   private:
+    friend class ChainedTable;
+    template <bool kOtherConst>
+    friend class BasicIterator;
+
+    BasicIterator(Owner* table, size_t bucket, ListIterator it) : table_(table), bucket_(bucket), it_(it) {
+    }
+
+    // Переходит к первой непустой корзине, начиная с текущей позиции; за последней корзиной - end()
+    void SkipEmpty() {
+      size_t total = table_->TotalBuckets();
+      while (bucket_ < total && it_ == table_->BucketAt(bucket_).end()) {
+        ++bucket_;
+        it_ = bucket_ < total ? table_->BucketAt(bucket_).begin() : ListIterator();
+      }
+    }
+
+    Owner* table_ = nullptr;
+    size_t bucket_ = 0;
+    ListIterator it_ = {};
+  };
+
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
+  // Извлеченный из таблицы узел: значение остается в том же узле списка и вставляется обратно без выделения памяти
+  class NodeHandle {
+   public:
+    NodeHandle() = default;
+
+    bool Empty() const {
+      return node_.empty();
+    }
+    const ValueT& Value() const {
+      return node_.front();
+    }
+    ValueT& Value() {
+      return node_.front();
+    }
+
+   private:
+    friend class ChainedTable;
+
+    List node_ = {};
+  };
+
+  ChainedTable() = default;
+  explicit ChainedTable(size_t count);
+
+  size_t Size() const;
+  void Clear();
+
+  // Ключ хэшируется один раз: по хэшу находится корзина, при росте таблицы корзина пересчитывается по нему же
+  std::pair<Iterator, bool> Insert(const ValueT&);
+  std::pair<Iterator, bool> Insert(ValueT&&);
+  // Если ключа key нет, строит значение из args прямо в новом узле; иначе args не используются
+  template <class K, class... Args>
+  std::pair<Iterator, bool> Emplace(const K& key, Args&&... args);
+  template <class K>
+  void Erase(const K&);
+  template <class K>
+  Iterator Find(const K&);
+  template <class K>
+  ConstIterator Find(const K&) const;
+
+  // Пачки по kBatch ключей: сначала все ключи пачки хэшируются и их корзины запрашиваются в кэш,
+  // затем идут вставки или поиски, так что промахи кэша соседних ключей перекрываются.
+  // InsertBatch заранее расширяет таблицу под все значения диапазона, повторяющиеся ключи пропускает
+  template <class ForwardIterator>
+  void InsertBatch(ForwardIterator begin, ForwardIterator end);
+  // found[i] - есть ли keys[i]
+  template <class K>
+  void FindBatch(const K* keys, size_t count, bool* found) const;
+
+  // Узел переходит между таблицами целиком: значение не копируется и не перемещается
+  template <class K>
+  NodeHandle Extract(const K&);
+  // Если ключ уже есть, узел остается в node
+  std::pair<Iterator, bool> Insert(NodeHandle&& node);
+  // Переносит в таблицу узлы other, которых в ней нет; корзины расширяются один раз под суммарный размер
+  void Merge(ChainedTable& other);
+  // Передает каждое значение в func по rvalue-ссылке и оставляет таблицу пустой, даже если func бросит исключение
+  template <class Function>
+  void Drain(Function func);
+
+  Iterator begin();  // NOLINT
+  Iterator end();  // NOLINT
+  ConstIterator begin() const;  // NOLINT
+  ConstIterator end() const;  // NOLINT
+
+  // Перестраивают таблицу сразу, предварительно закончив начатый перенос
+  void Rehash(size_t new_bucket_count);
+  void Reserve(size_t new_bucket_count);
+
+  // Корзины новой таблицы
+  size_t BucketCount() const;
+  size_t BucketSize(size_t id) const;
+  template <class K>
+  size_t Bucket(const K& key) const;
+
+#if UNORDERED_SET_STATS
+  const TableStats& Stats() const;
+  // Статистика и текущие длины цепочек обеих таблиц одной JSON-строкой
+  void WriteStatsJson(std::ostream& out) const;
+#endif
+
+ private:
+  template <class K>
+  size_t HashOf(const K& key) const;
+  // Общая часть вставки по уже посчитанному хэшу: если ключа нет, place кладет узел в конец выбранной корзины
+  template <class K, class Place>
+  std::pair<Iterator, bool> InsertWith(const K& key, size_t hash, Place place);
+  // Заранее запрашивает заголовок корзины ключа с этим хэшем
+  void Prefetch(size_t hash) const;
+  template <class K>
+  typename List::const_iterator FindIn(const List& bucket, const K& key) const;
+  // Номер корзины, где лежит ключ, и позиция в ней; если ключа нет - корзина новой таблицы и ее end()
+  template <class K>
+  std::pair<size_t, typename List::const_iterator> Locate(const K& key, size_t hash) const;
+  // erase пустого диапазона превращает const_iterator в iterator на ту же позицию
+  Iterator MakeIterator(size_t index, typename List::const_iterator it);
+
+  // Сквозная нумерация корзин: сначала новая таблица, за ней старая
+  size_t TotalBuckets() const;
+  const List& BucketAt(size_t index) const;
+  List& BucketAt(size_t index);
+
+  static constexpr size_t kBatch = 16;
+  static constexpr size_t kMigrateBuckets = 8;
+  void Grow();
+  void MigrateStep();
+  void FinishMigration();
+
+#if UNORDERED_SET_STATS
+  // Корзины и узлы списков без служебных данных распределителя
+  size_t MemoryBytes() const;
+#endif
+
+  std::vector<List> keys_ = {};
+  std::vector<List> old_keys_ = {};
+  size_t migrated_ = 0;
+  size_t count_elements_ = 0;
+  Hash hash_ = {};
+  KeyEqual equal_ = {};
+#if UNORDERED_SET_STATS
+  mutable TableStats stats_;
+#endif
+};
+
+// Конструкторы
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::ChainedTable(size_t count)
+    : keys_(count == 0 ? 0 : RoundUpToPowerOfTwo(count)) {
+}
+
+// Методы
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Size() const {
+  return count_elements_;
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Clear() {
+  count_elements_ = 0;
+  keys_ = std::vector<List>();
+  old_keys_ = std::vector<List>();
+  migrated_ = 0;
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::HashOf(const K& key) const {
+#if UNORDERED_SET_STATS
+  stats_.RecordHash();
+#endif
+  return hash_(key);
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::List::const_iterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::FindIn(const List& bucket, const K& key) const {
+  return std::find_if(bucket.begin(), bucket.end(),
+                      [&](const ValueT& el) { return equal_(Policy::KeyOf(el), key); });
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+std::pair<size_t, typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::List::const_iterator>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Locate(const K& key, size_t hash) const {
+  size_t index = FibonacciBucket(hash, keys_.size());
+  auto it = FindIn(keys_[index], key);
+#if UNORDERED_SET_STATS
+  size_t probes = std::distance(keys_[index].begin(), it) + (it != keys_[index].end());
+#endif
+  if constexpr (kIncremental) {
+    if (it == keys_[index].end() && !old_keys_.empty()) {
+      size_t old_index = FibonacciBucket(hash, old_keys_.size());
+      auto old_it = FindIn(old_keys_[old_index], key);
+#if UNORDERED_SET_STATS
+      probes += std::distance(old_keys_[old_index].begin(), old_it) + (old_it != old_keys_[old_index].end());
+#endif
+      if (old_it != old_keys_[old_index].end()) {
+#if UNORDERED_SET_STATS
+        stats_.RecordProbe(probes);
+#endif
+        return {keys_.size() + old_index, old_it};
+      }
+    }
+  }
+#if UNORDERED_SET_STATS
+  stats_.RecordProbe(probes);
+#endif
+  return {index, it};
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::MakeIterator(size_t index, typename List::const_iterator it) {
+  return Iterator(this, index, BucketAt(index).erase(it, it));
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::TotalBuckets() const {
+  return keys_.size() + old_keys_.size();
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+const typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::List&
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::BucketAt(size_t index) const {
+  return index < keys_.size() ? keys_[index] : old_keys_[index - keys_.size()];
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::List&
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::BucketAt(size_t index) {
+  return index < keys_.size() ? keys_[index] : old_keys_[index - keys_.size()];
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Erase(const K& key) {
+  if (keys_.empty()) {
+    return;
+  }
+  auto [index, it] = Locate(key, HashOf(key));
+  if (it != BucketAt(index).end()) {
+    BucketAt(index).erase(it);
+    count_elements_ -= 1;
+    MigrateStep();
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::ConstIterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Find(const K& key) const {
+  if (keys_.empty()) {
+    return end();
+  }
+  auto [index, it] = Locate(key, HashOf(key));
+  if (it == BucketAt(index).end()) {
+    return end();
+  }
+  return ConstIterator(this, index, it);
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Find(const K& key) {
+  if (keys_.empty()) {
+    return end();
+  }
+  auto [index, it] = Locate(key, HashOf(key));
+  if (it == BucketAt(index).end()) {
+    return end();
+  }
+  return MakeIterator(index, it);
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Prefetch(size_t hash) const {
+  __builtin_prefetch(&keys_[FibonacciBucket(hash, keys_.size())]);
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class ForwardIterator>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::InsertBatch(ForwardIterator begin, ForwardIterator end) {
+  size_t count = std::distance(begin, end);
+  if (count == 0) {
+    return;
+  }
+  Reserve(count_elements_ + count);
+  size_t hashes[kBatch];
+  while (begin != end) {
+    size_t batch = 0;
+    for (auto it = begin; batch < kBatch && it != end; ++it, ++batch) {
+      hashes[batch] = HashOf(Policy::KeyOf(*it));
+      Prefetch(hashes[batch]);
+    }
+    for (size_t i = 0; i < batch; ++i, ++begin) {
+      const ValueT& value = *begin;
+      InsertWith(Policy::KeyOf(value), hashes[i], [&](List& bucket) { bucket.push_back(value); });
+    }
+  }
+}
+
+// Узлы списка лежат отдельно от корзин, поэтому пачка проходит в три шага: запросить корзины,
+// затем первые узлы непустых корзин, затем сравнить ключи
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::FindBatch(const K* keys, size_t count, bool* found) const {
+  if (keys_.empty()) {
+    std::fill(found, found + count, false);
+    return;
+  }
+  size_t hashes[kBatch];
+  for (size_t start = 0; start < count; start += kBatch) {
+    size_t batch = std::min(kBatch, count - start);
+    for (size_t i = 0; i < batch; ++i) {
+      hashes[i] = HashOf(keys[start + i]);
+      Prefetch(hashes[i]);
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      const List& bucket = keys_[FibonacciBucket(hashes[i], keys_.size())];
+      if (!bucket.empty()) {
+        __builtin_prefetch(&bucket.front());
+      }
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      auto [index, it] = Locate(keys[start + i], hashes[i]);
+      found[start + i] = it != BucketAt(index).end();
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::NodeHandle
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Extract(const K& key) {
+  NodeHandle node;
+  if (keys_.empty()) {
+    return node;
+  }
+  auto [index, it] = Locate(key, HashOf(key));
+  if (it != BucketAt(index).end()) {
+    node.node_.splice(node.node_.end(), BucketAt(index), it);
+    count_elements_ -= 1;
+    MigrateStep();
+  }
+  return node;
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+std::pair<typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator, bool>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Insert(NodeHandle&& node) {
+  if (node.Empty()) {
+    return {end(), false};
+  }
+  const KeyT& key = Policy::KeyOf(node.Value());
+  return InsertWith(key, HashOf(key), [&](List& bucket) { bucket.splice(bucket.end(), node.node_); });
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Merge(ChainedTable& other) {
+  if (&other == this || other.count_elements_ == 0) {
+    return;
+  }
+  Reserve(count_elements_ + other.count_elements_);
+  for (size_t index = 0; index < other.TotalBuckets(); ++index) {
+    auto& bucket = other.BucketAt(index);
+    for (auto it = bucket.begin(); it != bucket.end();) {
+      auto next = std::next(it);
+      const KeyT& key = Policy::KeyOf(*it);
+      if (InsertWith(key, HashOf(key), [&](List& target) { target.splice(target.end(), bucket, it); }).second) {
+        other.count_elements_ -= 1;
+      }
+      it = next;
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class Function>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Drain(Function func) {
+  try {
+    for (size_t index = 0; index < TotalBuckets(); ++index) {
+      for (auto& value : BucketAt(index)) {
+        func(std::move(value));
+      }
+    }
+  } catch (...) {
+    Clear();
+    throw;
+  }
+  Clear();
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Rehash(size_t new_bucket_count) {
+  if (new_bucket_count < count_elements_) {
+    return;
+  }
+  FinishMigration();
+  new_bucket_count = RoundUpToPowerOfTwo(new_bucket_count);
+  if (new_bucket_count != keys_.size()) {
+#if UNORDERED_SET_STATS
+    RehashTimer timer(stats_);
+#endif
+    std::vector<List> new_table(new_bucket_count);
+#if UNORDERED_SET_STATS
+    stats_.RecordMemory(MemoryBytes() + new_table.capacity() * sizeof(List));
+#endif
+    for (auto& bucket : keys_) {
+      while (!bucket.empty()) {
+        size_t bucket_index = FibonacciBucket(HashOf(Policy::KeyOf(bucket.front())), new_bucket_count);
+        new_table[bucket_index].splice(new_table[bucket_index].end(), bucket, bucket.begin());
+      }
+    }
+    keys_ = std::move(new_table);
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Grow() {
+  if constexpr (kIncremental) {
+    FinishMigration();
+#if UNORDERED_SET_STATS
+    RehashTimer timer(stats_);
+#endif
+    old_keys_ = std::move(keys_);
+    keys_ = std::vector<List>(old_keys_.size() * 2);
+    migrated_ = 0;
+  } else {
+    Rehash(BucketCount() * 2);
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::MigrateStep() {
+  if constexpr (kIncremental) {
+    if (old_keys_.empty()) {
+      return;
+    }
+#if UNORDERED_SET_STATS
+    RehashTimer timer(stats_, false);
+#endif
+    size_t end = std::min(old_keys_.size(), migrated_ + kMigrateBuckets);
+    for (; migrated_ < end; ++migrated_) {
+      auto& bucket = old_keys_[migrated_];
+      while (!bucket.empty()) {
+        size_t bucket_index = FibonacciBucket(HashOf(Policy::KeyOf(bucket.front())), keys_.size());
+        keys_[bucket_index].splice(keys_[bucket_index].end(), bucket, bucket.begin());
+      }
+    }
+    if (migrated_ == old_keys_.size()) {
+      old_keys_ = std::vector<List>();
+      migrated_ = 0;
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::FinishMigration() {
+  while (!old_keys_.empty()) {
+    MigrateStep();
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Reserve(size_t new_bucket_count) {
+  if (new_bucket_count > keys_.size()) {
+    Rehash(new_bucket_count);
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+std::pair<typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator, bool>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Insert(const ValueT& value) {
+  return Emplace(Policy::KeyOf(value), value);
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+std::pair<typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator, bool>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Insert(ValueT&& value) {
+  return Emplace(Policy::KeyOf(value), std::move(value));
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K, class... Args>
+std::pair<typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator, bool>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Emplace(const K& key, Args&&... args) {
+  return InsertWith(key, HashOf(key), [&](List& bucket) { bucket.emplace_back(std::forward<Args>(args)...); });
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K, class Place>
+std::pair<typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator, bool>
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::InsertWith(const K& key, size_t hash, Place place) {
+  if (BucketCount() == 0) {
+    keys_.resize(1);
+  }
+  auto [found_index, it] = Locate(key, hash);
+  if (it != BucketAt(found_index).end()) {
+    return {MakeIterator(found_index, it), false};
+  }
+  MigrateStep();
+  if (1.0 * count_elements_ / keys_.size() >= 1) {
+    Grow();
+  }
+  size_t index = FibonacciBucket(hash, keys_.size());
+  place(keys_[index]);
+  count_elements_ += 1;
+#if UNORDERED_SET_STATS
+  stats_.RecordMemory(MemoryBytes());
+#endif
+  return {Iterator(this, index, std::prev(keys_[index].end())), true};
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::BucketCount() const {
+  return keys_.size();
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::BucketSize(size_t id) const {
+  if (id >= keys_.size()) {
+    return 0;
+  }
+  return keys_[id].size();
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+template <class K>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Bucket(const K& key) const {
+  if (keys_.empty()) {
+    return 0;
+  }
+  return FibonacciBucket(HashOf(key), keys_.size());
+}
+
+#if UNORDERED_SET_STATS
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+size_t ChainedTable<Policy, Hash, KeyEqual, kIncremental>::MemoryBytes() const {
+  return (keys_.capacity() + old_keys_.capacity()) * sizeof(List) +
+         count_elements_ * (sizeof(ValueT) + 2 * sizeof(void*));
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+const TableStats& ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Stats() const {
+  return stats_;
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+void ChainedTable<Policy, Hash, KeyEqual, kIncremental>::WriteStatsJson(std::ostream& out) const {
+  TableStats::Histogram chain_lengths = {};
+  for (const auto& bucket : keys_) {
+    ++chain_lengths[std::min(bucket.size(), TableStats::kHistogramSize - 1)];
+  }
+  // Уже перенесенные корзины старой таблицы пусты и не считаются
+  for (size_t index = migrated_; index < old_keys_.size(); ++index) {
+    ++chain_lengths[std::min(old_keys_[index].size(), TableStats::kHistogramSize - 1)];
+  }
+  ::WriteStatsJson(out, stats_, count_elements_, keys_.size(), MemoryBytes(), "chain_lengths", chain_lengths);
+}
+#endif
+
+// Итераторы
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::begin() {  // NOLINT
+  if (TotalBuckets() == 0) {
+    return end();
+  }
+  Iterator it(this, 0, keys_[0].begin());
+  it.SkipEmpty();
+  return it;
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::Iterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::end() {  // NOLINT
+  return Iterator(this, TotalBuckets(), {});
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::ConstIterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::begin() const {  // NOLINT
+  if (TotalBuckets() == 0) {
+    return end();
+  }
+  ConstIterator it(this, 0, keys_[0].begin());
+  it.SkipEmpty();
+  return it;
+}
+
+template <class Policy, class Hash, class KeyEqual, bool kIncremental>
+typename ChainedTable<Policy, Hash, KeyEqual, kIncremental>::ConstIterator
+ChainedTable<Policy, Hash, KeyEqual, kIncremental>::end() const {  // NOLINT
+  return ConstIterator(this, TotalBuckets(), {});
+}
+#endif  // CHAINED_TABLE_H
@@ -0,0 +1,178 @@
+#ifndef CONCURRENT_UNORDERED_SET_H
+#define CONCURRENT_UNORDERED_SET_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <utility>
+
+#include "unordered_set.h"
+
+// Потокобезопасное множество из независимых шардов: у каждого шарда своя таблица и свой shared_mutex,
+// поиск берет разделяемую блокировку, вставка и удаление - исключительную, и только на свой шард.
+// Шард растет под своей блокировкой, поэтому перестроение одного шарда не останавливает остальные.
+// Шард выбирается по старшим битам хэша, а внутри шарда таблица использует остальные
+template <class KeyT, class Layout = ChainedLayout, class Hash = DefaultHash<KeyT>,
+          class KeyEqual = DefaultKeyEqual<KeyT>>
+class ConcurrentUnorderedSet {
+ public:
+  // По умолчанию по четыре шарда на поток, округляя до степени двойки
+  ConcurrentUnorderedSet();
+  explicit ConcurrentUnorderedSet(size_t shard_count);
+
+  ConcurrentUnorderedSet(const ConcurrentUnorderedSet&) = delete;
+  ConcurrentUnorderedSet& operator=(const ConcurrentUnorderedSet&) = delete;
+
+  // Во время параллельных изменений Size и LoadFactor дают значение на момент обхода шардов
+  size_t Size() const;
+  bool Empty() const;
+  void Clear();
+
+  bool Insert(const KeyT&);
+  bool Insert(KeyT&&);
+  void Erase(const KeyT&);
+  bool Find(const KeyT&) const;
+
+  // Распределяет new_bucket_count поровну между шардами
+  void Rehash(size_t new_bucket_count);
+  void Reserve(size_t new_bucket_count);
+
+  size_t ShardCount() const;
+  size_t BucketCount() const;
+  double LoadFactor() const;
+
+ private:
+  using Set = UnorderedSet<KeyT, Layout, Hash, KeyEqual>;
+
+  // Шарды выровнены по строке кэша, чтобы блокировки соседних шардов не делили одну строку
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    Set set;
+  };
+
+  Shard& ShardFor(const KeyT& key) const;
+
+  std::unique_ptr<Shard[]> shards_;
+  size_t shard_count_ = 0;
+  size_t shard_shift_ = 0;
+  Hash hash_ = {};
+};
+
+// Конструкторы
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::ConcurrentUnorderedSet()
+    : ConcurrentUnorderedSet(4 * std::max(1u, std::thread::hardware_concurrency())) {
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::ConcurrentUnorderedSet(size_t shard_count)
+    : shard_count_(RoundUpToPowerOfTwo(std::max<size_t>(shard_count, 1))) {
+  shards_ = std::make_unique<Shard[]>(shard_count_);
+  shard_shift_ = 64 - __builtin_ctzll(shard_count_);
+}
+
+// Методы
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+typename ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Shard&
+ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::ShardFor(const KeyT& key) const {
+  if (shard_count_ == 1) {
+    return shards_[0];
+  }
+  return shards_[static_cast<uint64_t>(hash_(key)) >> shard_shift_];
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Size() const {
+  size_t size = 0;
+  for (size_t i = 0; i < shard_count_; ++i) {
+    std::shared_lock lock(shards_[i].mutex);
+    size += shards_[i].set.Size();
+  }
+  return size;
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+bool ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Empty() const {
+  return Size() == 0;
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Clear() {
+  for (size_t i = 0; i < shard_count_; ++i) {
+    std::unique_lock lock(shards_[i].mutex);
+    shards_[i].set.Clear();
+  }
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+bool ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Insert(const KeyT& key) {
+  Shard& shard = ShardFor(key);
+  std::unique_lock lock(shard.mutex);
+  return shard.set.Insert(key).second;
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+bool ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Insert(KeyT&& key) {
+  Shard& shard = ShardFor(key);
+  std::unique_lock lock(shard.mutex);
+  return shard.set.Insert(std::move(key)).second;
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Erase(const KeyT& key) {
+  Shard& shard = ShardFor(key);
+  std::unique_lock lock(shard.mutex);
+  shard.set.Erase(key);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+bool ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Find(const KeyT& key) const {
+  Shard& shard = ShardFor(key);
+  std::shared_lock lock(shard.mutex);
+  return shard.set.Find(key);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Rehash(size_t new_bucket_count) {
+  for (size_t i = 0; i < shard_count_; ++i) {
+    std::unique_lock lock(shards_[i].mutex);
+    shards_[i].set.Rehash((new_bucket_count + shard_count_ - 1) / shard_count_);
+  }
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::Reserve(size_t new_bucket_count) {
+  for (size_t i = 0; i < shard_count_; ++i) {
+    std::unique_lock lock(shards_[i].mutex);
+    shards_[i].set.Reserve((new_bucket_count + shard_count_ - 1) / shard_count_);
+  }
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::ShardCount() const {
+  return shard_count_;
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::BucketCount() const {
+  size_t count = 0;
+  for (size_t i = 0; i < shard_count_; ++i) {
+    std::shared_lock lock(shards_[i].mutex);
+    count += shards_[i].set.BucketCount();
+  }
+  return count;
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+double ConcurrentUnorderedSet<KeyT, Layout, Hash, KeyEqual>::LoadFactor() const {
+  size_t buckets = BucketCount();
+  if (buckets == 0) {
+    return 0;
+  }
+  return 1.0 * Size() / buckets;
+}
+#endif  // CONCURRENT_UNORDERED_SET_H
@@ -0,0 +1,233 @@
+#ifndef FILTERED_TABLE_H
+#define FILTERED_TABLE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "bloom_filter.h"
+
+// Таблица Inner с фильтром Блума перед ней: ключ, которого нет в фильтре, точно отсутствует в таблице,
+// поэтому промах стоит одной строки кэша фильтра вместо обхода корзины или групп слотов.
+// Удалять из фильтра нельзя, поэтому удаленные ключи остаются в нем до перестроения. Фильтр строится
+// заново по таблице, когда живых и удаленных ключей вместе становится больше его емкости
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+class FilteredTable : public InnerLayout::template Table<Policy, Hash, KeyEqual> {
+  using Base = typename InnerLayout::template Table<Policy, Hash, KeyEqual>;
+  using Filter = BloomFilter<typename Policy::Key, Hash>;
+
+ public:
+  using KeyT = typename Policy::Key;
+  using ValueT = typename Policy::Value;
+  using Iterator = typename Base::Iterator;
+  using ConstIterator = typename Base::ConstIterator;
+  using NodeHandle = typename Base::NodeHandle;
+
+  FilteredTable() = default;
+  explicit FilteredTable(size_t count);
+
+  void Clear();
+
+  std::pair<Iterator, bool> Insert(const ValueT&);
+  std::pair<Iterator, bool> Insert(ValueT&&);
+  template <class K, class... Args>
+  std::pair<Iterator, bool> Emplace(const K& key, Args&&... args);
+  template <class K>
+  void Erase(const K&);
+  template <class K>
+  Iterator Find(const K&);
+  template <class K>
+  ConstIterator Find(const K&) const;
+
+  template <class ForwardIterator>
+  void InsertBatch(ForwardIterator begin, ForwardIterator end);
+  template <class K>
+  void FindBatch(const K* keys, size_t count, bool* found) const;
+
+  template <class K>
+  NodeHandle Extract(const K&);
+  std::pair<Iterator, bool> Insert(NodeHandle&& node);
+  void Merge(FilteredTable& other);
+  template <class Function>
+  void Drain(Function func);
+
+  void Reserve(size_t new_bucket_count);
+
+ private:
+  static constexpr size_t kMinCapacity = 16;
+  static constexpr size_t kBatch = 16;
+
+  // Добавляет в фильтр только что вставленный ключ или перестраивает фильтр, если он переполнен
+  std::pair<Iterator, bool> Added(std::pair<Iterator, bool> result);
+  void Rebuild(size_t capacity);
+  void Reset();
+
+  Filter filter_ = {};
+  size_t removed_ = 0;
+};
+
+// Конструкторы
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::FilteredTable(size_t count)
+    : Base(count), filter_(std::max(count, kMinCapacity), kBitsPerKey) {
+}
+
+// Методы
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Reset() {
+  filter_ = Filter();
+  removed_ = 0;
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Rebuild(size_t capacity) {
+  filter_ = Filter(std::max(capacity, kMinCapacity), kBitsPerKey);
+  removed_ = 0;
+  for (auto it = Base::begin(); it != Base::end(); ++it) {
+    filter_.Insert(Policy::KeyOf(*it));
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+std::pair<typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Iterator, bool>
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Added(std::pair<Iterator, bool> result) {
+  if (result.second) {
+    if (Base::Size() + removed_ > filter_.Capacity()) {
+      Rebuild(2 * Base::Size());
+    } else {
+      filter_.Insert(Policy::KeyOf(*result.first));
+    }
+  }
+  return result;
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Clear() {
+  Base::Clear();
+  Reset();
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+std::pair<typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Iterator, bool>
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Insert(const ValueT& value) {
+  return Added(Base::Insert(value));
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+std::pair<typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Iterator, bool>
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Insert(ValueT&& value) {
+  return Added(Base::Insert(std::move(value)));
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class K, class... Args>
+std::pair<typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Iterator, bool>
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Emplace(const K& key, Args&&... args) {
+  return Added(Base::Emplace(key, std::forward<Args>(args)...));
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class K>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Erase(const K& key) {
+  size_t size = Base::Size();
+  Base::Erase(key);
+  removed_ += size - Base::Size();
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class K>
+typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Iterator
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Find(const K& key) {
+  if (!filter_.MayContain(key)) {
+    return Base::end();
+  }
+  return Base::Find(key);
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class K>
+typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::ConstIterator
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Find(const K& key) const {
+  if (!filter_.MayContain(key)) {
+    return Base::end();
+  }
+  return Base::Find(key);
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class ForwardIterator>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::InsertBatch(ForwardIterator begin,
+                                                                                  ForwardIterator end) {
+  Base::InsertBatch(begin, end);
+  if (Base::Size() + removed_ > filter_.Capacity()) {
+    Rebuild(2 * Base::Size());
+    return;
+  }
+  // Повторы ключей ставят те же биты, поэтому диапазон добавляется целиком
+  for (; begin != end; ++begin) {
+    filter_.Insert(Policy::KeyOf(*begin));
+  }
+}
+
+// Фильтр проверяется пачкой с предвыборкой блоков, в таблицу идут только ключи, прошедшие фильтр
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class K>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::FindBatch(const K* keys, size_t count,
+                                                                                bool* found) const {
+  uint64_t hashes[kBatch];
+  for (size_t start = 0; start < count; start += kBatch) {
+    size_t batch = std::min(kBatch, count - start);
+    for (size_t i = 0; i < batch; ++i) {
+      hashes[i] = filter_.HashOf(keys[start + i]);
+      filter_.Prefetch(hashes[i]);
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      found[start + i] = filter_.MayContainHash(hashes[i]) && Base::Find(keys[start + i]) != Base::end();
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class K>
+typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::NodeHandle
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Extract(const K& key) {
+  NodeHandle node = Base::Extract(key);
+  if (!node.Empty()) {
+    ++removed_;
+  }
+  return node;
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+std::pair<typename FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Iterator, bool>
+FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Insert(NodeHandle&& node) {
+  return Added(Base::Insert(std::move(node)));
+}
+
+// Какие ключи перешли из other, неизвестно, поэтому фильтр строится заново
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Merge(FilteredTable& other) {
+  size_t other_size = other.Size();
+  Base::Merge(other);
+  size_t moved = other_size - other.Size();
+  if (moved != 0) {
+    other.removed_ += moved;
+    Rebuild(std::max(filter_.Capacity(), 2 * Base::Size()));
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+template <class Function>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Drain(Function func) {
+  Base::Drain(func);
+  Reset();
+}
+
+template <class Policy, class Hash, class KeyEqual, class InnerLayout, size_t kBitsPerKey>
+void FilteredTable<Policy, Hash, KeyEqual, InnerLayout, kBitsPerKey>::Reserve(size_t new_bucket_count) {
+  Base::Reserve(new_bucket_count);
+  if (new_bucket_count > filter_.Capacity()) {
+    Rebuild(new_bucket_count);
+  }
+}
+#endif  // FILTERED_TABLE_H
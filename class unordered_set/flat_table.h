@@ -0,0 +1,1086 @@
+#ifndef FLAT_TABLE_H
+#define FLAT_TABLE_H
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "hash.h"
+#include "table_policy.h"
+#include "table_stats.h"
+
+// Широкий поиск по двум группам с AVX2: включается при запуске, если процессор поддерживает AVX2.
+// Определите FLAT_TABLE_WIDE_PROBE 0, чтобы всегда искать по одной группе
+#ifndef FLAT_TABLE_WIDE_PROBE
+#if defined(__x86_64__) || defined(__i386__)
+#define FLAT_TABLE_WIDE_PROBE 1
+#else
+#define FLAT_TABLE_WIDE_PROBE 0
+#endif
+#endif
+
+// Открытая адресация в стиле SwissTable: значения лежат прямо в массиве слотов, а рядом - массив
+// управляющих байтов, по одному на слот. Байт хранит 7 младших бит хэша занятого слота или
+// пометку "пусто"/"удалено", поэтому почти все несовпадения отсекаются без обращения к ключам.
+// Слоты разбиты на группы по kGroupWidth, поиск просматривает группу целиком и переходит
+// к следующей группе по квадратичной последовательности, пока не встретит группу с пустым слотом.
+// Группа сравнивается одной SSE2-инструкцией, а на процессорах с AVX2 (проверяется при запуске)
+// поиск сравнивает сразу окно из двух групп
+namespace flat_table_detail {
+constexpr uint8_t kEmpty = 0x80;
+constexpr uint8_t kDeleted = 0xFE;
+constexpr size_t kGroupWidth = 16;
+
+inline bool IsFull(uint8_t control) {
+  return control < 0x80;
+}
+
+// Битовые маски слотов группы: бит i соответствует слоту i
+#ifdef __SSE2__
+struct Group {
+  static constexpr size_t kWidth = kGroupWidth;
+
+  explicit Group(const uint8_t* control)
+      : control_(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control))) {
+  }
+
+  uint32_t Match(uint8_t tag) const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(tag)), control_)));
+  }
+
+  uint32_t MatchEmpty() const {
+    return Match(kEmpty);
+  }
+
+  // У пустых и удаленных слотов старший бит установлен, у занятых - нет
+  uint32_t MatchFree() const {
+    return static_cast<uint32_t>(_mm_movemask_epi8(control_));
+  }
+
+ private:
+  __m128i control_;
+};
+#else
+struct Group {
+  static constexpr size_t kWidth = kGroupWidth;
+
+  explicit Group(const uint8_t* control) : control_(control) {
+  }
+
+  uint32_t Match(uint8_t tag) const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<uint32_t>(control_[i] == tag) << i;
+    }
+    return mask;
+  }
+
+  uint32_t MatchEmpty() const {
+    return Match(kEmpty);
+  }
+
+  uint32_t MatchFree() const {
+    uint32_t mask = 0;
+    for (size_t i = 0; i < kWidth; ++i) {
+      mask |= static_cast<uint32_t>(!IsFull(control_[i])) << i;
+    }
+    return mask;
+  }
+
+ private:
+  const uint8_t* control_;
+};
+#endif
+
+#if FLAT_TABLE_WIDE_PROBE
+// Окно из двух соседних групп; методы компилируются под AVX2 и вызываются только после проверки процессора
+struct WideGroup {
+  static constexpr size_t kWidth = 2 * kGroupWidth;
+
+  __attribute__((target("avx2"))) explicit WideGroup(const uint8_t* control)
+      : control_(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(control))) {
+  }
+
+  __attribute__((target("avx2"))) uint32_t Match(uint8_t tag) const {
+    return static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_set1_epi8(static_cast<char>(tag)), control_)));
+  }
+
+  __attribute__((target("avx2"))) uint32_t MatchEmpty() const {
+    return Match(kEmpty);
+  }
+
+  __attribute__((target("avx2"))) uint32_t MatchFree() const {
+    return static_cast<uint32_t>(_mm256_movemask_epi8(control_));
+  }
+
+ private:
+  __m256i control_;
+};
+
+inline bool HasAvx2() {
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2;
+}
+#endif
+
+inline size_t LowestBit(uint32_t mask) {
+  return static_cast<size_t>(__builtin_ctz(mask));
+}
+
+// Заголовок снимка, за ним управляющие байты и с выравниванием kSnapshotAlign - слоты
+constexpr char kSnapshotMagic[8] = {'F', 'L', 'A', 'T', 'S', 'N', 'A', 'P'};
+constexpr uint32_t kSnapshotFormat = 1;
+constexpr uint32_t kSnapshotByteOrder = 0x01020304;
+constexpr size_t kSnapshotAlign = 64;
+
+struct SnapshotHeader {
+  char magic[8];
+  uint32_t format;
+  uint32_t hash_version;
+  uint64_t capacity;
+  uint64_t size;
+  uint32_t value_size;
+  uint32_t value_align;
+  uint64_t slots_offset;
+  uint32_t byte_order;
+  uint8_t reserved[12];
+};
+static_assert(sizeof(SnapshotHeader) == kSnapshotAlign, "SnapshotHeader must fill one cache line");
+}  // namespace flat_table_detail
+
+template <class Policy, class Hash = DefaultHash<typename Policy::Key>,
+          class KeyEqual = DefaultKeyEqual<typename Policy::Key>>
+class FlatTable {
+ public:
+  using KeyT = typename Policy::Key;
+  using ValueT = typename Policy::Value;
+
+  // Прямой итератор по слотам в порядке массива; пустые слоты пропускаются по группе за раз.
+  // Действителен до следующей вставки или удаления
+  template <bool kIsConst>
+  class BasicIterator {
+    using Owner = std::conditional_t<kIsConst, const FlatTable, FlatTable>;
+
+   public:
+    using iterator_category = std::forward_iterator_tag;  // NOLINT
+    using difference_type = std::ptrdiff_t;  // NOLINT
+    using value_type = ValueT;  // NOLINT
+    using reference = std::conditional_t<kIsConst, const ValueT&, ValueT&>;  // NOLINT
+    using pointer = std::conditional_t<kIsConst, const ValueT*, ValueT*>;  // NOLINT
+
+    BasicIterator() = default;
+    template <bool kOtherConst, class = std::enable_if_t<kIsConst && !kOtherConst>>
+    BasicIterator(const BasicIterator<kOtherConst>& other)  // NOLINT
+        : table_(other.table_), index_(other.index_) {
+    }
+
+    reference operator*() const {
+      return table_->slots_[index_];
+    }
+    pointer operator->() const {
+      return table_->slots_ + index_;
+    }
+    BasicIterator& operator++() {
+      index_ = table_->NextFull(index_ + 1);
+      return *this;
+    }
+    BasicIterator operator++(int) {
+      BasicIterator helper = *this;
+      ++(*this);
+      return helper;
+    }
+    friend bool operator==(const BasicIterator& first, const BasicIterator& second) {
+      return first.index_ == second.index_;
+    }
+    friend bool operator!=(const BasicIterator& first, const BasicIterator& second) {
+      return first.index_ != second.index_;
+    }
+
+   private:
+    friend class FlatTable;
+    template <bool kOtherConst>
+    friend class BasicIterator;
+
+    BasicIterator(Owner* table, size_t index) : table_(table), index_(index) {
+    }
+
+    Owner* table_ = nullptr;
+    size_t index_ = 0;
+  };
+
+  using Iterator = BasicIterator<false>;
+  using ConstIterator = BasicIterator<true>;
+
+  // Извлеченное из таблицы значение; слот освобождается сразу, само значение перемещается в NodeHandle
+  class NodeHandle {
+   public:
+    NodeHandle() = default;
+
+    bool Empty() const {
+      return !value_.has_value();
+    }
+    const ValueT& Value() const {
+      return *value_;
+    }
+    ValueT& Value() {
+      return *value_;
+    }
+
+   private:
+    friend class FlatTable;
+
+    std::optional<ValueT> value_ = {};
+  };
+
+  FlatTable() = default;
+  explicit FlatTable(size_t count);
+
+  FlatTable(const FlatTable&);
+  FlatTable(FlatTable&&) noexcept;
+
+  FlatTable& operator=(const FlatTable&);
+  FlatTable& operator=(FlatTable&&) noexcept;
+
+  ~FlatTable();
+
+  size_t Size() const;
+  void Clear();
+
+  // Ключ хэшируется один раз, поиск и выбор свободного слота идут за один проход
+  std::pair<Iterator, bool> Insert(const ValueT&);
+  std::pair<Iterator, bool> Insert(ValueT&&);
+  // Если ключа key нет, строит значение из args прямо в свободном слоте; иначе args не используются
+  template <class K, class... Args>
+  std::pair<Iterator, bool> Emplace(const K& key, Args&&... args);
+  template <class K>
+  void Erase(const K&);
+  template <class K>
+  Iterator Find(const K&);
+  template <class K>
+  ConstIterator Find(const K&) const;
+
+  // Пачки по kBatch ключей: сначала все ключи пачки хэшируются и их стартовые группы запрашиваются в кэш,
+  // затем идут вставки или поиски, так что промахи кэша соседних ключей перекрываются.
+  // InsertBatch заранее расширяет таблицу под все значения диапазона, повторяющиеся ключи пропускает
+  template <class ForwardIterator>
+  void InsertBatch(ForwardIterator begin, ForwardIterator end);
+  // found[i] - есть ли keys[i]
+  template <class K>
+  void FindBatch(const K* keys, size_t count, bool* found) const;
+
+  template <class K>
+  NodeHandle Extract(const K&);
+  // Если ключ уже есть, значение остается в node
+  std::pair<Iterator, bool> Insert(NodeHandle&& node);
+  // Переносит в таблицу значения other, ключей которых в ней нет; место резервируется один раз под суммарный размер
+  void Merge(FlatTable& other);
+  // Передает каждое значение в func по rvalue-ссылке и оставляет таблицу пустой, даже если func бросит исключение
+  template <class Function>
+  void Drain(Function func);
+
+  Iterator begin();  // NOLINT
+  Iterator end();  // NOLINT
+  ConstIterator begin() const;  // NOLINT
+  ConstIterator end() const;  // NOLINT
+
+  void Rehash(size_t new_bucket_count);
+  void Reserve(size_t new_bucket_count);
+
+  // Корзина - один слот, Bucket возвращает первый слот стартовой группы ключа
+  size_t BucketCount() const;
+  size_t BucketSize(size_t id) const;
+  template <class K>
+  size_t Bucket(const K& key) const;
+
+  // Снимок для отображения в память: заголовок с версией хэша, числом слотов и размером значения,
+  // затем управляющие байты вместе с копией первой группы и массив слотов как есть (пустые слоты - нули).
+  // Только для тривиально копируемых значений
+  void WriteSnapshot(std::ostream& out) const;
+  // Таблица только для чтения поверх снимка [data, data + length): ничего не копирует и не перестраивает.
+  // Память должна жить дольше таблицы; вставлять в такую таблицу и удалять из нее нельзя,
+  // копия такой таблицы - обычная таблица со своей памятью
+  static FlatTable ViewSnapshot(const void* data, size_t length);
+
+#if UNORDERED_SET_STATS
+  const TableStats& Stats() const;
+  // Статистика и для каждого ключа число групп на пути поиска до него одной JSON-строкой
+  void WriteStatsJson(std::ostream& out) const;
+#endif
+
+ private:
+  static size_t SnapshotSlotsOffset(size_t capacity);
+
+  // Заполненность не выше 7/8
+  static size_t MaxLoad(size_t capacity);
+  static size_t CapacityFor(size_t count);
+
+  template <class K>
+  size_t HashOf(const K& key) const;
+  static uint8_t Tag(size_t hash);
+  size_t HomeGroup(size_t hash) const;
+
+  // Индекс слота с ключом или capacity_, если ключа нет. Если free_index не nullptr,
+  // туда записывается первый свободный или удаленный слот на пройденном пути
+  template <class K>
+  size_t FindIndex(const K& key, size_t hash, size_t* free_index = nullptr) const;
+  // Первый свободный или удаленный слот на пути поиска
+  size_t FindFreeIndex(size_t hash) const;
+  template <class GroupT, class K>
+  __attribute__((always_inline)) inline size_t FindIndexIn(const K& key, size_t hash, size_t* free_index) const;
+  template <class GroupT>
+  __attribute__((always_inline)) inline size_t FindFreeIndexIn(size_t hash) const;
+#if FLAT_TABLE_WIDE_PROBE
+  template <class K>
+  size_t FindIndexWide(const K& key, size_t hash, size_t* free_index) const;
+  size_t FindFreeIndexWide(size_t hash) const;
+#endif
+
+  template <class K, class... Args>
+  std::pair<Iterator, bool> EmplaceHashed(const K& key, size_t hash, Args&&... args);
+  // Заранее запрашивает управляющие байты и слоты стартовой группы ключа с этим хэшем
+  void Prefetch(size_t hash) const;
+  static constexpr size_t kBatch = 16;
+
+  void SetControl(size_t index, uint8_t control);
+  void EraseIndex(size_t index);
+  // Первый занятый слот начиная с index или capacity_
+  size_t NextFull(size_t index) const;
+  void Resize(size_t new_capacity);
+
+  // Работа с памятью: за управляющими байтами лежит копия первой группы
+  static size_t ControlBytes(size_t capacity);
+  void Allocate(size_t capacity);
+  void Deallocate();
+  void DestroyAll();
+#if UNORDERED_SET_STATS
+  size_t MemoryBytes() const;
+#endif
+
+  uint8_t* ctrl_ = nullptr;
+  ValueT* slots_ = nullptr;
+  size_t capacity_ = 0;
+  size_t size_ = 0;
+  size_t growth_left_ = 0;
+  // Память принадлежит снимку, а не таблице
+  bool borrowed_ = false;
+  Hash hash_ = {};
+  KeyEqual equal_ = {};
+#if UNORDERED_SET_STATS
+  mutable TableStats stats_;
+#endif
+};
+
+// Конструкторы
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual>::FlatTable(size_t count) {
+  if (count > 0) {
+    Allocate(CapacityFor(count));
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual>::FlatTable(const FlatTable& other) : hash_(other.hash_), equal_(other.equal_) {
+  if (other.capacity_ == 0) {
+    return;
+  }
+  Allocate(other.capacity_);
+  size_t index = 0;
+  try {
+    for (; index < capacity_; ++index) {
+      if (flat_table_detail::IsFull(other.ctrl_[index])) {
+        new (slots_ + index) ValueT(other.slots_[index]);
+      }
+    }
+  } catch (...) {
+    for (size_t i = 0; i < index; ++i) {
+      if (flat_table_detail::IsFull(other.ctrl_[i])) {
+        slots_[i].~ValueT();
+      }
+    }
+    Deallocate();
+    throw;
+  }
+  std::memcpy(ctrl_, other.ctrl_, ControlBytes(capacity_));
+  size_ = other.size_;
+  growth_left_ = other.growth_left_;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual>::FlatTable(FlatTable&& other) noexcept
+    : ctrl_(std::exchange(other.ctrl_, nullptr)),
+      slots_(std::exchange(other.slots_, nullptr)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      size_(std::exchange(other.size_, 0)),
+      growth_left_(std::exchange(other.growth_left_, 0)),
+      borrowed_(std::exchange(other.borrowed_, false)),
+      hash_(other.hash_),
+      equal_(other.equal_) {
+}
+
+// Присваивание
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual>& FlatTable<Policy, Hash, KeyEqual>::operator=(const FlatTable& other) {
+  if (this != &other) {
+    *this = FlatTable(other);
+  }
+  return *this;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual>& FlatTable<Policy, Hash, KeyEqual>::operator=(FlatTable&& other) noexcept {
+  if (this != &other) {
+    Clear();
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(size_, other.size_);
+    std::swap(growth_left_, other.growth_left_);
+    std::swap(borrowed_, other.borrowed_);
+    hash_ = other.hash_;
+    equal_ = other.equal_;
+  }
+  return *this;
+}
+
+// Деструктор
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual>::~FlatTable() {
+  Clear();
+}
+
+// Работа с памятью
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Allocate(size_t capacity) {
+  slots_ = std::allocator<ValueT>().allocate(capacity);
+  try {
+    ctrl_ = std::allocator<uint8_t>().allocate(ControlBytes(capacity));
+  } catch (...) {
+    std::allocator<ValueT>().deallocate(slots_, capacity);
+    slots_ = nullptr;
+    throw;
+  }
+  std::memset(ctrl_, flat_table_detail::kEmpty, ControlBytes(capacity));
+  capacity_ = capacity;
+  size_ = 0;
+  growth_left_ = MaxLoad(capacity);
+#if UNORDERED_SET_STATS
+  stats_.RecordMemory(MemoryBytes());
+#endif
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::ControlBytes(size_t capacity) {
+  return capacity + flat_table_detail::kGroupWidth;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Deallocate() {
+  if (capacity_ != 0) {
+    std::allocator<uint8_t>().deallocate(ctrl_, ControlBytes(capacity_));
+    std::allocator<ValueT>().deallocate(slots_, capacity_);
+  }
+  ctrl_ = nullptr;
+  slots_ = nullptr;
+  capacity_ = 0;
+  size_ = 0;
+  growth_left_ = 0;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::DestroyAll() {
+  for (size_t i = 0; i < capacity_; ++i) {
+    if (flat_table_detail::IsFull(ctrl_[i])) {
+      slots_[i].~ValueT();
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::MaxLoad(size_t capacity) {
+  return capacity - capacity / 8;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::CapacityFor(size_t count) {
+  size_t capacity = flat_table_detail::kGroupWidth;
+  while (MaxLoad(capacity) < count) {
+    capacity *= 2;
+  }
+  return capacity;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Resize(size_t new_capacity) {
+#if UNORDERED_SET_STATS
+  RehashTimer timer(stats_, size_ != 0);
+#endif
+  FlatTable fresh;
+  fresh.hash_ = hash_;
+  fresh.equal_ = equal_;
+  fresh.Allocate(new_capacity);
+#if UNORDERED_SET_STATS
+  // Пока значения переносятся, старые и новые слоты заняты одновременно
+  stats_.RecordMemory(MemoryBytes() + fresh.MemoryBytes());
+#endif
+  for (size_t i = 0; i < capacity_; ++i) {
+    if (flat_table_detail::IsFull(ctrl_[i])) {
+      size_t hash = HashOf(Policy::KeyOf(slots_[i]));
+      size_t index = fresh.FindFreeIndex(hash);
+      new (fresh.slots_ + index) ValueT(std::move_if_noexcept(slots_[i]));
+      fresh.SetControl(index, Tag(hash));
+      ++fresh.size_;
+      --fresh.growth_left_;
+    }
+  }
+  *this = std::move(fresh);
+}
+
+// Методы
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+size_t FlatTable<Policy, Hash, KeyEqual>::HashOf(const K& key) const {
+#if UNORDERED_SET_STATS
+  stats_.RecordHash();
+#endif
+  return hash_(key);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+uint8_t FlatTable<Policy, Hash, KeyEqual>::Tag(size_t hash) {
+  return static_cast<uint8_t>(hash & 0x7F);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::HomeGroup(size_t hash) const {
+  return FibonacciBucket(hash, capacity_ / flat_table_detail::kGroupWidth);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+size_t FlatTable<Policy, Hash, KeyEqual>::FindIndex(const K& key, size_t hash, size_t* free_index) const {
+  if (capacity_ == 0) {
+    return capacity_;
+  }
+#if FLAT_TABLE_WIDE_PROBE
+  if (flat_table_detail::HasAvx2()) {
+    return FindIndexWide(key, hash, free_index);
+  }
+#endif
+  return FindIndexIn<flat_table_detail::Group>(key, hash, free_index);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::FindFreeIndex(size_t hash) const {
+#if FLAT_TABLE_WIDE_PROBE
+  if (flat_table_detail::HasAvx2()) {
+    return FindFreeIndexWide(hash);
+  }
+#endif
+  return FindFreeIndexIn<flat_table_detail::Group>(hash);
+}
+
+#if FLAT_TABLE_WIDE_PROBE
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+__attribute__((target("avx2"))) size_t FlatTable<Policy, Hash, KeyEqual>::FindIndexWide(const K& key, size_t hash,
+                                                                                      size_t* free_index) const {
+  return FindIndexIn<flat_table_detail::WideGroup>(key, hash, free_index);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+__attribute__((target("avx2"))) size_t FlatTable<Policy, Hash, KeyEqual>::FindFreeIndexWide(size_t hash) const {
+  return FindFreeIndexIn<flat_table_detail::WideGroup>(hash);
+}
+#endif
+
+// Окно w начинается через 2 * w * (w + 1) / 2 групп от стартовой и состоит из двух соседних групп,
+// при степени двойки групп окна покрывают всю таблицу. Широкая группа читает окно целиком,
+// копия первой группы за концом массива позволяет читать окно, начинающееся с последней группы.
+// Ключ лежит в первой группе пути, где при вставке был свободный слот, поэтому узкий поиск
+// останавливается на первой группе с пустым слотом, а широкий - на первом таком окне
+template <class Policy, class Hash, class KeyEqual>
+template <class GroupT, class K>
+size_t FlatTable<Policy, Hash, KeyEqual>::FindIndexIn(const K& key, size_t hash, size_t* free_index) const {
+  size_t groups = capacity_ / flat_table_detail::kGroupWidth;
+  size_t group = HomeGroup(hash);
+  uint8_t tag = Tag(hash);
+#if UNORDERED_SET_STATS
+  // Записывает длину при любом выходе из поиска
+  struct ProbeCount {
+    TableStats& stats;
+    size_t groups = 0;
+    ~ProbeCount() {
+      stats.RecordProbe(groups);
+    }
+  } probes{stats_};
+#endif
+  for (size_t window = 0; window < groups; ++window) {
+    for (size_t part = 0; part < 2 * flat_table_detail::kGroupWidth / GroupT::kWidth; ++part) {
+      size_t base = ((group + part) & (groups - 1)) * flat_table_detail::kGroupWidth;
+      GroupT slots(ctrl_ + base);
+#if UNORDERED_SET_STATS
+      probes.groups += GroupT::kWidth / flat_table_detail::kGroupWidth;
+#endif
+      for (uint32_t mask = slots.Match(tag); mask != 0; mask &= mask - 1) {
+        size_t index = (base + flat_table_detail::LowestBit(mask)) & (capacity_ - 1);
+        if (equal_(Policy::KeyOf(slots_[index]), key)) {
+          return index;
+        }
+      }
+      if (free_index != nullptr && *free_index == capacity_) {
+        uint32_t free = slots.MatchFree();
+        if (free != 0) {
+          *free_index = (base + flat_table_detail::LowestBit(free)) & (capacity_ - 1);
+        }
+      }
+      if (slots.MatchEmpty() != 0) {
+        return capacity_;
+      }
+    }
+    group = (group + 2 * (window + 1)) & (groups - 1);
+  }
+  return capacity_;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class GroupT>
+size_t FlatTable<Policy, Hash, KeyEqual>::FindFreeIndexIn(size_t hash) const {
+  size_t groups = capacity_ / flat_table_detail::kGroupWidth;
+  size_t group = HomeGroup(hash);
+  for (size_t window = 0;; ++window) {
+    for (size_t part = 0; part < 2 * flat_table_detail::kGroupWidth / GroupT::kWidth; ++part) {
+      size_t base = ((group + part) & (groups - 1)) * flat_table_detail::kGroupWidth;
+      uint32_t mask = GroupT(ctrl_ + base).MatchFree();
+      if (mask != 0) {
+        return (base + flat_table_detail::LowestBit(mask)) & (capacity_ - 1);
+      }
+    }
+    group = (group + 2 * (window + 1)) & (groups - 1);
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::SetControl(size_t index, uint8_t control) {
+  ctrl_[index] = control;
+  if (index < flat_table_detail::kGroupWidth) {
+    ctrl_[capacity_ + index] = control;
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::Size() const {
+  return size_;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Clear() {
+  if (borrowed_) {
+    ctrl_ = nullptr;
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    borrowed_ = false;
+    return;
+  }
+  DestroyAll();
+  Deallocate();
+}
+
+template <class Policy, class Hash, class KeyEqual>
+std::pair<typename FlatTable<Policy, Hash, KeyEqual>::Iterator, bool> FlatTable<Policy, Hash, KeyEqual>::Insert(
+    const ValueT& value) {
+  return Emplace(Policy::KeyOf(value), value);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+std::pair<typename FlatTable<Policy, Hash, KeyEqual>::Iterator, bool> FlatTable<Policy, Hash, KeyEqual>::Insert(
+    ValueT&& value) {
+  return Emplace(Policy::KeyOf(value), std::move(value));
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K, class... Args>
+std::pair<typename FlatTable<Policy, Hash, KeyEqual>::Iterator, bool> FlatTable<Policy, Hash, KeyEqual>::Emplace(
+    const K& key, Args&&... args) {
+  return EmplaceHashed(key, HashOf(key), std::forward<Args>(args)...);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K, class... Args>
+std::pair<typename FlatTable<Policy, Hash, KeyEqual>::Iterator, bool>
+FlatTable<Policy, Hash, KeyEqual>::EmplaceHashed(const K& key, size_t hash, Args&&... args) {
+  size_t index = capacity_;
+  size_t found = FindIndex(key, hash, &index);
+  if (found != capacity_) {
+    return {Iterator(this, found), false};
+  }
+  // Удаленный слот занимается без роста, пустой - только пока есть запас
+  if (capacity_ == 0 || (growth_left_ == 0 && ctrl_[index] == flat_table_detail::kEmpty)) {
+    Resize(CapacityFor(size_ + 1));
+    index = FindFreeIndex(hash);
+  }
+  new (slots_ + index) ValueT(std::forward<Args>(args)...);
+  if (ctrl_[index] == flat_table_detail::kEmpty) {
+    --growth_left_;
+  }
+  SetControl(index, Tag(hash));
+  ++size_;
+  return {Iterator(this, index), true};
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+void FlatTable<Policy, Hash, KeyEqual>::Erase(const K& key) {
+  size_t index = FindIndex(key, HashOf(key));
+  if (index != capacity_) {
+    EraseIndex(index);
+  }
+}
+
+// Если в группе уже был пустой слот, ни одна последовательность поиска не проходила через нее дальше,
+// и слот можно сразу пометить пустым, иначе остается пометка "удалено"
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::EraseIndex(size_t index) {
+  slots_[index].~ValueT();
+  size_t base = index - index % flat_table_detail::kGroupWidth;
+  if (flat_table_detail::Group(ctrl_ + base).MatchEmpty() != 0) {
+    SetControl(index, flat_table_detail::kEmpty);
+    ++growth_left_;
+  } else {
+    SetControl(index, flat_table_detail::kDeleted);
+  }
+  --size_;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+typename FlatTable<Policy, Hash, KeyEqual>::Iterator FlatTable<Policy, Hash, KeyEqual>::Find(const K& key) {
+  return Iterator(this, FindIndex(key, HashOf(key)));
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+typename FlatTable<Policy, Hash, KeyEqual>::ConstIterator FlatTable<Policy, Hash, KeyEqual>::Find(const K& key) const {
+  return ConstIterator(this, FindIndex(key, HashOf(key)));
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Prefetch(size_t hash) const {
+  size_t base = HomeGroup(hash) * flat_table_detail::kGroupWidth;
+  __builtin_prefetch(ctrl_ + base);
+  __builtin_prefetch(slots_ + base);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class ForwardIterator>
+void FlatTable<Policy, Hash, KeyEqual>::InsertBatch(ForwardIterator begin, ForwardIterator end) {
+  size_t count = std::distance(begin, end);
+  if (count == 0) {
+    return;
+  }
+  Reserve(size_ + count);
+  size_t hashes[kBatch];
+  while (begin != end) {
+    size_t batch = 0;
+    for (auto it = begin; batch < kBatch && it != end; ++it, ++batch) {
+      hashes[batch] = HashOf(Policy::KeyOf(*it));
+      Prefetch(hashes[batch]);
+    }
+    for (size_t i = 0; i < batch; ++i, ++begin) {
+      const ValueT& value = *begin;
+      EmplaceHashed(Policy::KeyOf(value), hashes[i], value);
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+void FlatTable<Policy, Hash, KeyEqual>::FindBatch(const K* keys, size_t count, bool* found) const {
+  if (capacity_ == 0) {
+    std::fill(found, found + count, false);
+    return;
+  }
+  size_t hashes[kBatch];
+  for (size_t start = 0; start < count; start += kBatch) {
+    size_t batch = std::min(kBatch, count - start);
+    for (size_t i = 0; i < batch; ++i) {
+      hashes[i] = HashOf(keys[start + i]);
+      Prefetch(hashes[i]);
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      found[start + i] = FindIndex(keys[start + i], hashes[i]) != capacity_;
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+typename FlatTable<Policy, Hash, KeyEqual>::NodeHandle FlatTable<Policy, Hash, KeyEqual>::Extract(const K& key) {
+  NodeHandle node;
+  size_t index = FindIndex(key, HashOf(key));
+  if (index != capacity_) {
+    node.value_.emplace(std::move(slots_[index]));
+    EraseIndex(index);
+  }
+  return node;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+std::pair<typename FlatTable<Policy, Hash, KeyEqual>::Iterator, bool> FlatTable<Policy, Hash, KeyEqual>::Insert(
+    NodeHandle&& node) {
+  if (node.Empty()) {
+    return {end(), false};
+  }
+  auto result = Emplace(Policy::KeyOf(*node.value_), std::move(*node.value_));
+  if (result.second) {
+    node.value_.reset();
+  }
+  return result;
+}
+
+// Emplace перемещает значение только при успешной вставке, поэтому значения с повторяющимися ключами остаются в other
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Merge(FlatTable& other) {
+  if (&other == this || other.size_ == 0) {
+    return;
+  }
+  Reserve(size_ + other.size_);
+  for (size_t index = 0; index < other.capacity_; ++index) {
+    if (flat_table_detail::IsFull(other.ctrl_[index]) &&
+        Emplace(Policy::KeyOf(other.slots_[index]), std::move(other.slots_[index])).second) {
+      other.EraseIndex(index);
+    }
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class Function>
+void FlatTable<Policy, Hash, KeyEqual>::Drain(Function func) {
+  try {
+    for (size_t index = NextFull(0); index < capacity_; index = NextFull(index + 1)) {
+      func(std::move(slots_[index]));
+    }
+  } catch (...) {
+    Clear();
+    throw;
+  }
+  Clear();
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Rehash(size_t new_bucket_count) {
+  size_t new_capacity = CapacityFor(size_);
+  while (new_capacity < new_bucket_count) {
+    new_capacity *= 2;
+  }
+  if (new_capacity != capacity_) {
+    Resize(new_capacity);
+  }
+}
+
+// Резервирует место под new_bucket_count ключей без перестроения таблицы
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::Reserve(size_t new_bucket_count) {
+  if (new_bucket_count > MaxLoad(capacity_)) {
+    Resize(CapacityFor(std::max(new_bucket_count, size_)));
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::BucketCount() const {
+  return capacity_;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::BucketSize(size_t id) const {
+  if (id >= capacity_) {
+    return 0;
+  }
+  return flat_table_detail::IsFull(ctrl_[id]) ? 1 : 0;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+template <class K>
+size_t FlatTable<Policy, Hash, KeyEqual>::Bucket(const K& key) const {
+  if (capacity_ == 0) {
+    return 0;
+  }
+  return HomeGroup(HashOf(key)) * flat_table_detail::kGroupWidth;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::SnapshotSlotsOffset(size_t capacity) {
+  size_t end = sizeof(flat_table_detail::SnapshotHeader) + ControlBytes(capacity);
+  return (end + flat_table_detail::kSnapshotAlign - 1) / flat_table_detail::kSnapshotAlign *
+         flat_table_detail::kSnapshotAlign;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::WriteSnapshot(std::ostream& out) const {
+  static_assert(std::is_trivially_copyable_v<ValueT>, "Snapshots need trivially copyable values");
+  static_assert(alignof(ValueT) <= flat_table_detail::kSnapshotAlign, "Snapshot values are aligned to 64 bytes");
+  flat_table_detail::SnapshotHeader header = {};
+  std::memcpy(header.magic, flat_table_detail::kSnapshotMagic, sizeof(header.magic));
+  header.format = flat_table_detail::kSnapshotFormat;
+  header.hash_version = kHashVersion;
+  header.capacity = capacity_;
+  header.size = size_;
+  header.value_size = sizeof(ValueT);
+  header.value_align = alignof(ValueT);
+  header.slots_offset = SnapshotSlotsOffset(capacity_);
+  header.byte_order = flat_table_detail::kSnapshotByteOrder;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (capacity_ != 0) {
+    out.write(reinterpret_cast<const char*>(ctrl_), ControlBytes(capacity_));
+    const char padding[flat_table_detail::kSnapshotAlign] = {};
+    out.write(padding, header.slots_offset - sizeof(header) - ControlBytes(capacity_));
+    // Слоты пишутся кусками, чтобы обнулить пустые и не выносить в файл содержимое неинициализированной памяти
+    constexpr size_t kChunk = 4096;
+    auto chunk = std::make_unique<char[]>(kChunk * sizeof(ValueT));
+    for (size_t start = 0; start < capacity_; start += kChunk) {
+      size_t count = std::min(kChunk, capacity_ - start);
+      std::memset(chunk.get(), 0, count * sizeof(ValueT));
+      for (size_t i = 0; i < count; ++i) {
+        if (flat_table_detail::IsFull(ctrl_[start + i])) {
+          std::memcpy(chunk.get() + i * sizeof(ValueT), slots_ + start + i, sizeof(ValueT));
+        }
+      }
+      out.write(chunk.get(), count * sizeof(ValueT));
+    }
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write snapshot");
+  }
+}
+
+template <class Policy, class Hash, class KeyEqual>
+FlatTable<Policy, Hash, KeyEqual> FlatTable<Policy, Hash, KeyEqual>::ViewSnapshot(const void* data, size_t length) {
+  static_assert(std::is_trivially_copyable_v<ValueT>, "Snapshots need trivially copyable values");
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  flat_table_detail::SnapshotHeader header;
+  if (length < sizeof(header)) {
+    throw std::runtime_error("Snapshot is truncated");
+  }
+  std::memcpy(&header, bytes, sizeof(header));
+  if (std::memcmp(header.magic, flat_table_detail::kSnapshotMagic, sizeof(header.magic)) != 0) {
+    throw std::runtime_error("Not a FlatTable snapshot");
+  }
+  if (header.format != flat_table_detail::kSnapshotFormat ||
+      header.byte_order != flat_table_detail::kSnapshotByteOrder) {
+    throw std::runtime_error("Unsupported snapshot format");
+  }
+  if (header.hash_version != kHashVersion) {
+    throw std::runtime_error("Snapshot was built with a different hash version");
+  }
+  if (header.value_size != sizeof(ValueT) || header.value_align != alignof(ValueT)) {
+    throw std::runtime_error("Snapshot value type does not match");
+  }
+  FlatTable table;
+  if (header.capacity == 0) {
+    return table;
+  }
+  size_t capacity = header.capacity;
+  bool valid_capacity = capacity >= flat_table_detail::kGroupWidth && (capacity & (capacity - 1)) == 0 &&
+                        capacity <= (length - sizeof(header)) / sizeof(ValueT);
+  if (!valid_capacity || header.size > capacity || header.slots_offset != SnapshotSlotsOffset(capacity) ||
+      header.slots_offset + capacity * sizeof(ValueT) > length) {
+    throw std::runtime_error("Snapshot is corrupted");
+  }
+  if (reinterpret_cast<uintptr_t>(bytes + header.slots_offset) % alignof(ValueT) != 0) {
+    throw std::runtime_error("Snapshot is misaligned");
+  }
+  table.ctrl_ = const_cast<uint8_t*>(bytes + sizeof(header));
+  table.slots_ = reinterpret_cast<ValueT*>(const_cast<uint8_t*>(bytes + header.slots_offset));
+  table.capacity_ = capacity;
+  table.size_ = header.size;
+  table.borrowed_ = true;
+  return table;
+}
+
+#if UNORDERED_SET_STATS
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::MemoryBytes() const {
+  return capacity_ == 0 ? 0 : capacity_ * sizeof(ValueT) + ControlBytes(capacity_);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+const TableStats& FlatTable<Policy, Hash, KeyEqual>::Stats() const {
+  return stats_;
+}
+
+// Группы перебираются в том же порядке, что и при поиске; хэш здесь не попадает в hash_calls
+template <class Policy, class Hash, class KeyEqual>
+void FlatTable<Policy, Hash, KeyEqual>::WriteStatsJson(std::ostream& out) const {
+  TableStats::Histogram displacements = {};
+  size_t groups = capacity_ / flat_table_detail::kGroupWidth;
+  for (size_t index = 0; index < capacity_; ++index) {
+    if (!flat_table_detail::IsFull(ctrl_[index])) {
+      continue;
+    }
+    size_t target = index / flat_table_detail::kGroupWidth;
+    size_t group = HomeGroup(hash_(Policy::KeyOf(slots_[index])));
+    size_t visited = 0;
+    for (size_t window = 0;; ++window) {
+      if (group == target) {
+        visited += 1;
+        break;
+      }
+      if (((group + 1) & (groups - 1)) == target) {
+        visited += 2;
+        break;
+      }
+      visited += 2;
+      group = (group + 2 * (window + 1)) & (groups - 1);
+    }
+    ++displacements[std::min(visited, TableStats::kHistogramSize - 1)];
+  }
+  ::WriteStatsJson(out, stats_, size_, capacity_, MemoryBytes(), "displacements", displacements);
+}
+#endif
+
+// Итераторы
+template <class Policy, class Hash, class KeyEqual>
+size_t FlatTable<Policy, Hash, KeyEqual>::NextFull(size_t index) const {
+  for (; index < capacity_; index += flat_table_detail::kGroupWidth) {
+    // Пропускаем группу целиком по маске; байты за концом массива - копия первой группы, их отсекает min
+    uint32_t full = ~flat_table_detail::Group(ctrl_ + index).MatchFree() & 0xFFFF;
+    if (full != 0) {
+      return std::min(index + flat_table_detail::LowestBit(full), capacity_);
+    }
+  }
+  return capacity_;
+}
+
+template <class Policy, class Hash, class KeyEqual>
+typename FlatTable<Policy, Hash, KeyEqual>::Iterator FlatTable<Policy, Hash, KeyEqual>::begin() {  // NOLINT
+  return Iterator(this, NextFull(0));
+}
+
+template <class Policy, class Hash, class KeyEqual>
+typename FlatTable<Policy, Hash, KeyEqual>::Iterator FlatTable<Policy, Hash, KeyEqual>::end() {  // NOLINT
+  return Iterator(this, capacity_);
+}
+
+template <class Policy, class Hash, class KeyEqual>
+typename FlatTable<Policy, Hash, KeyEqual>::ConstIterator FlatTable<Policy, Hash, KeyEqual>::begin() const {  // NOLINT
+  return ConstIterator(this, NextFull(0));
+}
+
+template <class Policy, class Hash, class KeyEqual>
+typename FlatTable<Policy, Hash, KeyEqual>::ConstIterator FlatTable<Policy, Hash, KeyEqual>::end() const {  // NOLINT
+  return ConstIterator(this, capacity_);
+}
+#endif  // FLAT_TABLE_H
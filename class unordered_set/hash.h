@@ -0,0 +1,152 @@
+#ifndef HASH_H
+#define HASH_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Хэши по умолчанию для UnorderedSet. std::hash для целых в libstdc++ - тождественная функция,
+// из-за которой последовательные идентификаторы ложатся в соседние корзины, поэтому целые
+// перемешиваются умножением 64x64 -> 128 со сверткой половин, а байтовые строки хэшируются
+// по схеме wyhash: по 16 байт за шаг с той же сверткой
+namespace hash_detail {
+constexpr uint64_t kSecret0 = 0xa0761d6478bd642full;
+constexpr uint64_t kSecret1 = 0xe7037ed1a0b428dbull;
+constexpr uint64_t kSecret2 = 0x8ebc6af09c88c6e3ull;
+constexpr uint64_t kSecret3 = 0x589965cc75374cc3ull;
+
+inline void MultiplyFull(uint64_t& first, uint64_t& second) {
+  __uint128_t product = static_cast<__uint128_t>(first) * second;
+  first = static_cast<uint64_t>(product);
+  second = static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t MultiplyFold(uint64_t first, uint64_t second) {
+  MultiplyFull(first, second);
+  return first ^ second;
+}
+
+inline uint64_t Read64(const uint8_t* data) {
+  uint64_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+inline uint64_t Read32(const uint8_t* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+}  // namespace hash_detail
+
+// Версия хэшей по умолчанию: меняется при любом изменении HashBytes, HashInteger или FibonacciBucket,
+// потому что от них зависит раскладка сохраненных снимков FlatTable
+constexpr uint32_t kHashVersion = 1;
+
+inline uint64_t HashBytes(const void* data, size_t length, uint64_t seed = 0) {
+  using namespace hash_detail;
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  seed ^= MultiplyFold(seed ^ kSecret0, kSecret1);
+  uint64_t first = 0;
+  uint64_t second = 0;
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t middle = (length >> 3) << 2;
+      first = (Read32(bytes) << 32) | Read32(bytes + middle);
+      second = (Read32(bytes + length - 4) << 32) | Read32(bytes + length - 4 - middle);
+    } else if (length > 0) {
+      first = (static_cast<uint64_t>(bytes[0]) << 16) | (static_cast<uint64_t>(bytes[length >> 1]) << 8) |
+              bytes[length - 1];
+    }
+  } else {
+    size_t left = length;
+    if (left > 48) {
+      uint64_t seed1 = seed;
+      uint64_t seed2 = seed;
+      do {
+        seed = MultiplyFold(Read64(bytes) ^ kSecret1, Read64(bytes + 8) ^ seed);
+        seed1 = MultiplyFold(Read64(bytes + 16) ^ kSecret2, Read64(bytes + 24) ^ seed1);
+        seed2 = MultiplyFold(Read64(bytes + 32) ^ kSecret3, Read64(bytes + 40) ^ seed2);
+        bytes += 48;
+        left -= 48;
+      } while (left > 48);
+      seed ^= seed1 ^ seed2;
+    }
+    while (left > 16) {
+      seed = MultiplyFold(Read64(bytes) ^ kSecret1, Read64(bytes + 8) ^ seed);
+      bytes += 16;
+      left -= 16;
+    }
+    first = Read64(bytes + left - 16);
+    second = Read64(bytes + left - 8);
+  }
+  first ^= kSecret1;
+  second ^= seed;
+  MultiplyFull(first, second);
+  return MultiplyFold(first ^ kSecret0 ^ length, second ^ kSecret1);
+}
+
+inline uint64_t HashInteger(uint64_t value) {
+  return hash_detail::MultiplyFold(value ^ hash_detail::kSecret0, hash_detail::kSecret1);
+}
+
+// Корзина из bucket_count (степень двойки) по старшим битам произведения на 2^64 / φ
+inline size_t FibonacciBucket(uint64_t hash, size_t bucket_count) {
+  if (bucket_count <= 1) {
+    return 0;
+  }
+  return static_cast<size_t>((hash * 0x9e3779b97f4a7c15ull) >> (64 - __builtin_ctzll(bucket_count)));
+}
+
+inline size_t RoundUpToPowerOfTwo(size_t count) {
+  size_t result = 1;
+  while (result < count) {
+    result *= 2;
+  }
+  return result;
+}
+
+// Прозрачный хэш строк: принимает std::string, std::string_view и const char* и хэширует их одинаково,
+// поэтому множество строк ищет по std::string_view без построения временной строки
+struct StringHash {
+  using is_transparent = void;
+
+  size_t operator()(std::string_view key) const {
+    return HashBytes(key.data(), key.size());
+  }
+};
+
+template <class T>
+constexpr bool kIsStringKey = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+template <class T, class = void>
+struct DefaultHash {
+  size_t operator()(const T& key) const {
+    return HashInteger(std::hash<T>{}(key));
+  }
+};
+
+template <class T>
+struct DefaultHash<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+  size_t operator()(T key) const {
+    return HashInteger(static_cast<uint64_t>(key));
+  }
+};
+
+template <class T>
+struct DefaultHash<T*> {
+  size_t operator()(T* key) const {
+    return HashInteger(reinterpret_cast<uintptr_t>(key));
+  }
+};
+
+template <class T>
+struct DefaultHash<T, std::enable_if_t<kIsStringKey<T>>> : StringHash {};
+
+// Для строк сравнение тоже прозрачное, чтобы работал поиск по std::string_view
+template <class T>
+using DefaultKeyEqual = std::conditional_t<kIsStringKey<T>, std::equal_to<>, std::equal_to<T>>;
+#endif  // HASH_H
@@ -0,0 +1,306 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include "flat_table.h"
+#include "hash.h"
+#include "table_policy.h"
+
+// Множество только для чтения поверх файла, записанного UnorderedSet<KeyT, FlatLayout>::WriteSnapshot.
+// Файл отображается в память целиком, страницы подгружаются при первом обращении, таблица не перестраивается.
+// Hash должен давать те же значения, что и при записи: для хэшей по умолчанию это проверяет kHashVersion
+template <class KeyT, class Hash = DefaultHash<KeyT>, class KeyEqual = DefaultKeyEqual<KeyT>>
+class MappedUnorderedSet {
+  using Table = FlatTable<SetPolicy<KeyT>, Hash, KeyEqual>;
+
+  template <class K>
+  using EnableIfTransparent = EnableIfTransparentLookup<K, KeyT, Hash, KeyEqual>;
+
+ public:
+  using ConstIterator = typename Table::ConstIterator;
+  using Iterator = ConstIterator;
+
+  explicit MappedUnorderedSet(const std::string& path);
+
+  MappedUnorderedSet(const MappedUnorderedSet&) = delete;
+  MappedUnorderedSet(MappedUnorderedSet&&) noexcept;
+
+  MappedUnorderedSet& operator=(const MappedUnorderedSet&) = delete;
+  MappedUnorderedSet& operator=(MappedUnorderedSet&&) noexcept;
+
+  size_t Size() const;
+  bool Empty() const;
+
+  bool Find(const KeyT&) const;
+  template <class K, class = EnableIfTransparent<K>>
+  bool Find(const K&) const;
+  void FindBatch(const KeyT* keys, size_t count, bool* found) const;
+
+  Iterator begin() const;  // NOLINT
+  Iterator end() const;  // NOLINT
+
+  size_t BucketCount() const;
+  double LoadFactor() const;
+
+  ~MappedUnorderedSet();
+
+ private:
+  void Unmap();
+
+  void* data_ = nullptr;
+  size_t length_ = 0;
+  Table table_ = {};
+};
+
+// Потоковая запись по одному значению для ключей, которые нельзя сохранить снимком: строк, пар, map.
+// Формат: магия, версия, число значений, затем значения через KeySerializer; порядок байт - родной.
+// Для своих типов достаточно специализировать KeySerializer с методами Write и Read
+template <class T>
+struct KeySerializer {
+  static_assert(std::is_trivially_copyable_v<T>, "Specialize KeySerializer for this key type");
+
+  static void Write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  static T Read(std::istream& in) {
+    T value;
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+  }
+};
+
+template <>
+struct KeySerializer<std::string> {
+  static void Write(std::ostream& out, const std::string& value) {
+    KeySerializer<uint64_t>::Write(out, value.size());
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+  }
+
+  // Длина читается кусками, чтобы испорченная длина не приводила к огромному выделению памяти
+  static std::string Read(std::istream& in) {
+    constexpr size_t kChunk = 1 << 16;
+    uint64_t length = KeySerializer<uint64_t>::Read(in);
+    std::string value;
+    while (in && value.size() < length) {
+      size_t offset = value.size();
+      size_t count = std::min<uint64_t>(kChunk, length - offset);
+      value.resize(offset + count);
+      in.read(value.data() + offset, static_cast<std::streamsize>(count));
+    }
+    return value;
+  }
+};
+
+template <class First, class Second>
+struct KeySerializer<std::pair<First, Second>> {
+  static void Write(std::ostream& out, const std::pair<First, Second>& value) {
+    KeySerializer<std::remove_const_t<First>>::Write(out, value.first);
+    KeySerializer<std::remove_const_t<Second>>::Write(out, value.second);
+  }
+
+  static std::pair<First, Second> Read(std::istream& in) {
+    auto first = KeySerializer<std::remove_const_t<First>>::Read(in);
+    auto second = KeySerializer<std::remove_const_t<Second>>::Read(in);
+    return {std::move(first), std::move(second)};
+  }
+};
+
+namespace snapshot_detail {
+constexpr char kStreamMagic[8] = {'K', 'E', 'Y', 'S', 'T', 'R', 'M', '\0'};
+constexpr uint32_t kStreamFormat = 1;
+
+template <class Container>
+using ValueOf = std::decay_t<decltype(*std::declval<const Container&>().begin())>;
+}  // namespace snapshot_detail
+
+// Пишет все значения UnorderedSet или UnorderedMap любого устройства
+template <class Container>
+void Serialize(std::ostream& out, const Container& container);
+
+// Читает значения по одному и вставляет их, место в таблице резервируется заранее по числу из заголовка
+template <class Container>
+Container Deserialize(std::istream& in);
+
+// Конструкторы
+template <class KeyT, class Hash, class KeyEqual>
+MappedUnorderedSet<KeyT, Hash, KeyEqual>::MappedUnorderedSet(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "Failed to open " + path);
+  }
+  struct stat info = {};
+  if (fstat(fd, &info) != 0) {
+    int error = errno;
+    close(fd);
+    throw std::system_error(error, std::generic_category(), "Failed to stat " + path);
+  }
+  length_ = static_cast<size_t>(info.st_size);
+  if (length_ != 0) {
+    void* data = mmap(nullptr, length_, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      int error = errno;
+      close(fd);
+      throw std::system_error(error, std::generic_category(), "Failed to map " + path);
+    }
+    data_ = data;
+  }
+  // Отображение живет и после закрытия дескриптора
+  close(fd);
+  try {
+    table_ = Table::ViewSnapshot(data_, length_);
+  } catch (...) {
+    Unmap();
+    throw;
+  }
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+MappedUnorderedSet<KeyT, Hash, KeyEqual>::MappedUnorderedSet(MappedUnorderedSet&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      length_(std::exchange(other.length_, 0)),
+      table_(std::move(other.table_)) {
+}
+
+// Присваивание
+template <class KeyT, class Hash, class KeyEqual>
+MappedUnorderedSet<KeyT, Hash, KeyEqual>& MappedUnorderedSet<KeyT, Hash, KeyEqual>::operator=(
+    MappedUnorderedSet&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    table_ = std::move(other.table_);
+    data_ = std::exchange(other.data_, nullptr);
+    length_ = std::exchange(other.length_, 0);
+  }
+  return *this;
+}
+
+// Методы
+template <class KeyT, class Hash, class KeyEqual>
+size_t MappedUnorderedSet<KeyT, Hash, KeyEqual>::Size() const {
+  return table_.Size();
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+bool MappedUnorderedSet<KeyT, Hash, KeyEqual>::Empty() const {
+  return table_.Size() == 0;
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+bool MappedUnorderedSet<KeyT, Hash, KeyEqual>::Find(const KeyT& key) const {
+  return table_.Find(key) != table_.end();
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+template <class K, class>
+bool MappedUnorderedSet<KeyT, Hash, KeyEqual>::Find(const K& key) const {
+  return table_.Find(key) != table_.end();
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+void MappedUnorderedSet<KeyT, Hash, KeyEqual>::FindBatch(const KeyT* keys, size_t count, bool* found) const {
+  table_.FindBatch(keys, count, found);
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+size_t MappedUnorderedSet<KeyT, Hash, KeyEqual>::BucketCount() const {
+  return table_.BucketCount();
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+double MappedUnorderedSet<KeyT, Hash, KeyEqual>::LoadFactor() const {
+  if (table_.BucketCount() == 0) {
+    return 0;
+  }
+  return 1.0 * table_.Size() / table_.BucketCount();
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+void MappedUnorderedSet<KeyT, Hash, KeyEqual>::Unmap() {
+  table_.Clear();
+  if (data_ != nullptr) {
+    munmap(data_, length_);
+    data_ = nullptr;
+  }
+  length_ = 0;
+}
+
+template <class Container>
+void Serialize(std::ostream& out, const Container& container) {
+  using Value = snapshot_detail::ValueOf<Container>;
+  out.write(snapshot_detail::kStreamMagic, sizeof(snapshot_detail::kStreamMagic));
+  KeySerializer<uint32_t>::Write(out, snapshot_detail::kStreamFormat);
+  KeySerializer<uint64_t>::Write(out, container.Size());
+  for (const auto& value : container) {
+    KeySerializer<Value>::Write(out, value);
+  }
+  if (!out) {
+    throw std::runtime_error("Failed to write stream");
+  }
+}
+
+template <class Container>
+Container Deserialize(std::istream& in) {
+  using Value = snapshot_detail::ValueOf<Container>;
+  char magic[sizeof(snapshot_detail::kStreamMagic)] = {};
+  in.read(magic, sizeof(magic));
+  if (!in || std::memcmp(magic, snapshot_detail::kStreamMagic, sizeof(magic)) != 0) {
+    throw std::runtime_error("Not a serialized container");
+  }
+  if (KeySerializer<uint32_t>::Read(in) != snapshot_detail::kStreamFormat) {
+    throw std::runtime_error("Unsupported stream format");
+  }
+  uint64_t count = KeySerializer<uint64_t>::Read(in);
+  if (!in) {
+    throw std::runtime_error("Stream is truncated");
+  }
+  // Заранее резервируется не больше kMaxReserve, чтобы испорченное число не приводило к огромному выделению памяти;
+  // дальше таблица растет сама
+  constexpr uint64_t kMaxReserve = 1 << 20;
+  Container container;
+  container.Reserve(std::min(count, kMaxReserve));
+  for (uint64_t i = 0; i < count; ++i) {
+    Value value = KeySerializer<Value>::Read(in);
+    if (!in) {
+      throw std::runtime_error("Stream is truncated");
+    }
+    container.Insert(std::move(value));
+  }
+  return container;
+}
+
+// Деструктор
+template <class KeyT, class Hash, class KeyEqual>
+MappedUnorderedSet<KeyT, Hash, KeyEqual>::~MappedUnorderedSet() {
+  Unmap();
+}
+
+// Итераторы
+template <class KeyT, class Hash, class KeyEqual>
+typename MappedUnorderedSet<KeyT, Hash, KeyEqual>::Iterator MappedUnorderedSet<KeyT, Hash, KeyEqual>::begin()
+    const {  // NOLINT
+  return table_.begin();
+}
+
+template <class KeyT, class Hash, class KeyEqual>
+typename MappedUnorderedSet<KeyT, Hash, KeyEqual>::Iterator MappedUnorderedSet<KeyT, Hash, KeyEqual>::end()
+    const {  // NOLINT
+  return table_.end();
+}
+#endif  // SNAPSHOT_H
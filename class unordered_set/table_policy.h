@@ -0,0 +1,38 @@
+#ifndef TABLE_POLICY_H
+#define TABLE_POLICY_H
+#include <type_traits>
+#include <utility>
+
+// Что хранят таблицы и как достать ключ из хранимого значения. Таблица хэширует и сравнивает
+// только ключ, поэтому множество и отображение используют одни и те же корзины, слоты и перестроение
+template <class KeyT>
+struct SetPolicy {
+  using Key = KeyT;
+  using Value = KeyT;
+
+  static const Key& KeyOf(const Value& value) {
+    return value;
+  }
+};
+
+// Ключ и значение лежат вместе в одном узле или слоте, поэтому поиск читает одну строку кэша
+template <class KeyT, class MappedT>
+struct MapPolicy {
+  using Key = KeyT;
+  using Value = std::pair<const KeyT, MappedT>;
+
+  static const Key& KeyOf(const Value& value) {
+    return value.first;
+  }
+};
+
+// Поиск по типу, отличному от ключа, разрешен, только если и Hash, и KeyEqual объявляют is_transparent
+template <class T, class = void>
+struct IsTransparent : std::false_type {};
+template <class T>
+struct IsTransparent<T, std::void_t<typename T::is_transparent>> : std::true_type {};
+
+template <class K, class KeyT, class Hash, class KeyEqual>
+using EnableIfTransparentLookup =
+    std::enable_if_t<IsTransparent<Hash>::value && IsTransparent<KeyEqual>::value && !std::is_same_v<K, KeyT>>;
+#endif  // TABLE_POLICY_H
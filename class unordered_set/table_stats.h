@@ -0,0 +1,114 @@
+#ifndef TABLE_STATS_H
+#define TABLE_STATS_H
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+// Статистика таблиц, чтобы понять, почему конкретное множество медленное: гистограмма длин поиска,
+// число вызовов хэша, число и длительность перестроений, пиковый объем памяти.
+// По умолчанию не компилируется вовсе; определите UNORDERED_SET_STATS 1 до подключения заголовков,
+// и у UnorderedSet и UnorderedMap появятся Stats() и WriteStatsJson
+#ifndef UNORDERED_SET_STATS
+#define UNORDERED_SET_STATS 0
+#endif
+
+#if UNORDERED_SET_STATS
+// Счетчики атомарные с relaxed-порядком, поэтому поиск под разделяемой блокировкой в ConcurrentUnorderedSet
+// может их обновлять. Статистика принадлежит объекту таблицы: копия или перемещенная таблица начинает с нуля,
+// а при присваивании таблица сохраняет свои счетчики
+struct TableStats {
+  // Ячейка i - поиски длины i, последняя ячейка - kHistogramSize - 1 и длиннее
+  static constexpr size_t kHistogramSize = 32;
+  using Histogram = std::array<uint64_t, kHistogramSize>;
+
+  TableStats() = default;
+  TableStats(const TableStats&) {
+  }
+  TableStats& operator=(const TableStats&) {
+    return *this;
+  }
+
+  void RecordProbe(size_t length) {
+    probe_lengths[std::min(length, kHistogramSize - 1)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void RecordHash() {
+    hash_calls.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void RecordMemory(size_t bytes) {
+    uint64_t peak = peak_memory_bytes.load(std::memory_order_relaxed);
+    while (peak < bytes && !peak_memory_bytes.compare_exchange_weak(peak, bytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Длина поиска: для цепочек - число просмотренных узлов, для FlatTable - число просмотренных групп
+  // (с AVX2 группы читаются парами, поэтому длины четные)
+  std::atomic<uint64_t> probe_lengths[kHistogramSize] = {};
+  std::atomic<uint64_t> hash_calls = 0;
+  std::atomic<uint64_t> rehashes = 0;
+  std::atomic<uint64_t> rehash_nanoseconds = 0;
+  std::atomic<uint64_t> peak_memory_bytes = 0;
+};
+
+// Время жизни объекта добавляется к длительности перестроений; counted - считать ли это отдельным перестроением
+class RehashTimer {
+ public:
+  explicit RehashTimer(TableStats& stats, bool counted = true)
+      : stats_(stats), start_(std::chrono::steady_clock::now()) {
+    if (counted) {
+      stats_.rehashes.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  RehashTimer(const RehashTimer&) = delete;
+  RehashTimer& operator=(const RehashTimer&) = delete;
+
+  ~RehashTimer() {
+    auto elapsed = std::chrono::steady_clock::now() - start_;
+    stats_.rehash_nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                                        std::memory_order_relaxed);
+  }
+
+ private:
+  TableStats& stats_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+namespace table_stats_detail {
+template <class Values>
+void WriteArray(std::ostream& out, const Values& values) {
+  out << '[';
+  for (size_t i = 0; i < TableStats::kHistogramSize; ++i) {
+    out << (i == 0 ? "" : ",") << static_cast<uint64_t>(values[i]);
+  }
+  out << ']';
+}
+}  // namespace table_stats_detail
+
+// Одна JSON-строка. layout - распределение текущего содержимого под именем layout_name:
+// длины цепочек у ChainedTable, число групп до ключа у FlatTable
+inline void WriteStatsJson(std::ostream& out, const TableStats& stats, size_t size, size_t bucket_count,
+                           size_t memory_bytes, const char* layout_name, const TableStats::Histogram& layout) {
+  uint64_t lookups = 0;
+  for (const auto& count : stats.probe_lengths) {
+    lookups += count.load(std::memory_order_relaxed);
+  }
+  out << "{\"size\":" << size << ",\"bucket_count\":" << bucket_count
+      << ",\"load_factor\":" << (bucket_count == 0 ? 0.0 : 1.0 * size / bucket_count)
+      << ",\"hash_calls\":" << stats.hash_calls.load(std::memory_order_relaxed) << ",\"lookups\":" << lookups
+      << ",\"probe_lengths\":";
+  table_stats_detail::WriteArray(out, stats.probe_lengths);
+  out << ",\"" << layout_name << "\":";
+  table_stats_detail::WriteArray(out, layout);
+  out << ",\"rehashes\":" << stats.rehashes.load(std::memory_order_relaxed)
+      << ",\"rehash_nanoseconds\":" << stats.rehash_nanoseconds.load(std::memory_order_relaxed)
+      << ",\"memory_bytes\":" << memory_bytes << ",\"peak_memory_bytes\":"
+      << std::max<uint64_t>(memory_bytes, stats.peak_memory_bytes.load(std::memory_order_relaxed)) << "}";
+}
+#endif
+#endif  // TABLE_STATS_H
@@ -0,0 +1,379 @@
+#ifndef UNORDERED_MAP_H
+#define UNORDERED_MAP_H
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "hash.h"
+#include "table_policy.h"
+#include "unordered_set.h"
+
+// Отображение на тех же таблицах, что и UnorderedSet: хэш, корзины и перестроение общие,
+// а в узле или слоте лежит пара ключ-значение, поэтому поиск значения - это один поиск по таблице.
+// По умолчанию FlatLayout: пара хранится прямо в массиве слотов, без отдельного узла.
+// Разнородный поиск работает так же, как в UnorderedSet
+template <class KeyT, class MappedT, class Layout = FlatLayout, class Hash = DefaultHash<KeyT>,
+          class KeyEqual = DefaultKeyEqual<KeyT>>
+class UnorderedMap {
+  using Table = typename Layout::template Table<MapPolicy<KeyT, MappedT>, Hash, KeyEqual>;
+
+  template <class K>
+  using EnableIfTransparent = EnableIfTransparentLookup<K, KeyT, Hash, KeyEqual>;
+
+ public:
+  using ValueType = std::pair<const KeyT, MappedT>;
+  using Iterator = typename Table::Iterator;
+  using ConstIterator = typename Table::ConstIterator;
+
+  UnorderedMap() = default;
+  explicit UnorderedMap(size_t count);
+
+  template <class ForwardIterator>
+  UnorderedMap(ForwardIterator begin, ForwardIterator end);
+
+  UnorderedMap(const UnorderedMap&);
+  UnorderedMap(UnorderedMap&&) noexcept;
+
+  UnorderedMap& operator=(const UnorderedMap&);
+  UnorderedMap& operator=(UnorderedMap&&) noexcept;
+
+  size_t Size() const;
+  bool Empty() const;
+  void Clear();
+
+  // Если ключ уже есть, значение не меняется
+  std::pair<Iterator, bool> Insert(const ValueType&);
+  std::pair<Iterator, bool> Insert(ValueType&&);
+  // Строит значение из args, только если ключа еще нет; иначе ни ключ, ни args не перемещаются
+  template <class... Args>
+  std::pair<Iterator, bool> TryEmplace(const KeyT& key, Args&&... args);
+  template <class... Args>
+  std::pair<Iterator, bool> TryEmplace(KeyT&& key, Args&&... args);
+  // Вставляет или перезаписывает значение; second - была ли вставка
+  template <class M>
+  std::pair<Iterator, bool> InsertOrAssign(const KeyT& key, M&& value);
+  template <class M>
+  std::pair<Iterator, bool> InsertOrAssign(KeyT&& key, M&& value);
+
+  // Вставляет значение по умолчанию, если ключа нет
+  MappedT& operator[](const KeyT& key);
+  MappedT& operator[](KeyT&& key);
+
+  MappedT& At(const KeyT& key);
+  const MappedT& At(const KeyT& key) const;
+  template <class K, class = EnableIfTransparent<K>>
+  MappedT& At(const K& key);
+  template <class K, class = EnableIfTransparent<K>>
+  const MappedT& At(const K& key) const;
+
+  void Erase(const KeyT&);
+  template <class K, class = EnableIfTransparent<K>>
+  void Erase(const K&);
+
+  // end(), если ключа нет
+  Iterator Find(const KeyT&);
+  ConstIterator Find(const KeyT&) const;
+  template <class K, class = EnableIfTransparent<K>>
+  Iterator Find(const K&);
+  template <class K, class = EnableIfTransparent<K>>
+  ConstIterator Find(const K&) const;
+
+  bool Contains(const KeyT&) const;
+  template <class K, class = EnableIfTransparent<K>>
+  bool Contains(const K&) const;
+
+  void Rehash(size_t new_bucket_count);
+  void Reserve(size_t new_bucket_count);
+
+  Iterator begin();  // NOLINT
+  Iterator end();  // NOLINT
+  ConstIterator begin() const;  // NOLINT
+  ConstIterator end() const;  // NOLINT
+  ConstIterator cbegin() const;  // NOLINT
+  ConstIterator cend() const;  // NOLINT
+
+  size_t BucketCount() const;
+  double LoadFactor() const;
+
+#if UNORDERED_SET_STATS
+  // Как у UnorderedSet
+  const TableStats& Stats() const;
+  void WriteStatsJson(std::ostream& out) const;
+#endif
+
+ private:
+  Table table_ = {};
+};
+
+// Конструкторы
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::UnorderedMap(size_t count) : table_(count) {
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class ForwardIterator>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::UnorderedMap(ForwardIterator begin, ForwardIterator end) {
+  table_.InsertBatch(begin, end);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::UnorderedMap(const UnorderedMap& other) : table_(other.table_) {
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::UnorderedMap(UnorderedMap&& other) noexcept
+    : table_(std::move(other.table_)) {
+  other.table_.Clear();
+}
+
+// Присваивание
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::operator=(
+    const UnorderedMap& other) {
+  table_ = other.table_;
+  return *this;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::operator=(
+    UnorderedMap&& other) noexcept {
+  table_ = std::move(other.table_);
+  other.Clear();
+  return *this;
+}
+
+// Методы
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+size_t UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Size() const {
+  return table_.Size();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+bool UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Empty() const {
+  return table_.Size() == 0;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+void UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Clear() {
+  table_.Clear();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+std::pair<typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Insert(const ValueType& value) {
+  return table_.Insert(value);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+std::pair<typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Insert(ValueType&& value) {
+  return table_.Insert(std::move(value));
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class... Args>
+std::pair<typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::TryEmplace(const KeyT& key, Args&&... args) {
+  return table_.Emplace(key, std::piecewise_construct, std::forward_as_tuple(key),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class... Args>
+std::pair<typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::TryEmplace(KeyT&& key, Args&&... args) {
+  return table_.Emplace(key, std::piecewise_construct, std::forward_as_tuple(std::move(key)),
+                        std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class M>
+std::pair<typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::InsertOrAssign(const KeyT& key, M&& value) {
+  auto result = TryEmplace(key, std::forward<M>(value));
+  if (!result.second) {
+    result.first->second = std::forward<M>(value);
+  }
+  return result;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class M>
+std::pair<typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::InsertOrAssign(KeyT&& key, M&& value) {
+  auto result = TryEmplace(std::move(key), std::forward<M>(value));
+  if (!result.second) {
+    result.first->second = std::forward<M>(value);
+  }
+  return result;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+MappedT& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::operator[](const KeyT& key) {
+  return TryEmplace(key).first->second;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+MappedT& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::operator[](KeyT&& key) {
+  return TryEmplace(std::move(key)).first->second;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+MappedT& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::At(const KeyT& key) {
+  auto it = table_.Find(key);
+  if (it == table_.end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+const MappedT& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::At(const KeyT& key) const {
+  auto it = table_.Find(key);
+  if (it == table_.end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+MappedT& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::At(const K& key) {
+  auto it = table_.Find(key);
+  if (it == table_.end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+const MappedT& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::At(const K& key) const {
+  auto it = table_.Find(key);
+  if (it == table_.end()) {
+    throw std::out_of_range("Key not found");
+  }
+  return it->second;
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+void UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Erase(const KeyT& key) {
+  table_.Erase(key);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+void UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Erase(const K& key) {
+  table_.Erase(key);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Find(const KeyT& key) {
+  return table_.Find(key);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::ConstIterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Find(const KeyT& key) const {
+  return table_.Find(key);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Find(const K& key) {
+  return table_.Find(key);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::ConstIterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Find(const K& key) const {
+  return table_.Find(key);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+bool UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Contains(const KeyT& key) const {
+  return table_.Find(key) != table_.end();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+bool UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Contains(const K& key) const {
+  return table_.Find(key) != table_.end();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+void UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Rehash(size_t new_bucket_count) {
+  table_.Rehash(new_bucket_count);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+void UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Reserve(size_t new_bucket_count) {
+  table_.Reserve(new_bucket_count);
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+size_t UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::BucketCount() const {
+  return table_.BucketCount();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+double UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::LoadFactor() const {
+  if (table_.Size() == 0) {
+    return 0;
+  }
+  return 1.0 * table_.Size() / table_.BucketCount();
+}
+
+#if UNORDERED_SET_STATS
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+const TableStats& UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Stats() const {
+  return table_.Stats();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+void UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::WriteStatsJson(std::ostream& out) const {
+  table_.WriteStatsJson(out);
+}
+#endif
+
+// Итераторы
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::begin() {  // NOLINT
+  return table_.begin();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::Iterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::end() {  // NOLINT
+  return table_.end();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::ConstIterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::begin() const {  // NOLINT
+  return table_.begin();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::ConstIterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::end() const {  // NOLINT
+  return table_.end();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::ConstIterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::cbegin() const {  // NOLINT
+  return table_.begin();
+}
+
+template <class KeyT, class MappedT, class Layout, class Hash, class KeyEqual>
+typename UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::ConstIterator
+UnorderedMap<KeyT, MappedT, Layout, Hash, KeyEqual>::cend() const {  // NOLINT
+  return table_.end();
+}
+#endif  // UNORDERED_MAP_H
@@ -1,12 +1,62 @@
 #ifndef UNORDERED_SET_H
 #define UNORDERED_SET_H
 #include <algorithm>
-#include <list>
-#include <vector>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <utility>
 
-template <class KeyT>
+#include "chained_table.h"
+#include "filtered_table.h"
+#include "flat_table.h"
+#include "hash.h"
+#include "table_policy.h"
+
+// Способ хранения: ChainedLayout - корзины-списки, FlatLayout - открытая адресация
+// с управляющими байтами, без отдельного узла на каждый ключ. Policy задает, что лежит в таблице
+// (см. table_policy.h), поэтому те же layout используются и для UnorderedMap
+struct ChainedLayout {
+  template <class Policy, class Hash, class KeyEqual>
+  using Table = ChainedTable<Policy, Hash, KeyEqual>;
+};
+
+// Цепочки с постепенным перестроением: рост таблицы не останавливает вставку на время переноса всех ключей.
+// Пока перенос не закончен, вставка нового ключа и удаление делают итераторы недействительными
+struct IncrementalChainedLayout {
+  template <class Policy, class Hash, class KeyEqual>
+  using Table = ChainedTable<Policy, Hash, KeyEqual, true>;
+};
+
+struct FlatLayout {
+  template <class Policy, class Hash, class KeyEqual>
+  using Table = FlatTable<Policy, Hash, KeyEqual>;
+};
+
+// Inner с фильтром Блума на kBitsPerKey бит на ключ перед таблицей: для нагрузки, где поиск
+// в основном промахивается. Удачный поиск и вставка считают хэш дважды, для фильтра и для таблицы
+template <class Inner = ChainedLayout, size_t kBitsPerKey = 10>
+struct FilteredLayout {
+  template <class Policy, class Hash, class KeyEqual>
+  using Table = FilteredTable<Policy, Hash, KeyEqual, Inner, kBitsPerKey>;
+};
+
+// Если и Hash, и KeyEqual объявляют is_transparent, Find, Erase и Bucket принимают любой
+// совместимый с ключом тип, например std::string_view для std::string (для строк это так по умолчанию)
+template <class KeyT, class Layout = ChainedLayout, class Hash = DefaultHash<KeyT>,
+          class KeyEqual = DefaultKeyEqual<KeyT>>
 class UnorderedSet {
+  using Table = typename Layout::template Table<SetPolicy<KeyT>, Hash, KeyEqual>;
+
+  template <class K>
+  using EnableIfTransparent = EnableIfTransparentLookup<K, KeyT, Hash, KeyEqual>;
+
  public:
+  // Ключи в множестве менять нельзя, поэтому оба итератора константные.
+  // Обход идет в порядке хранения: корзина за корзиной или слот за слотом
+  using ConstIterator = typename Table::ConstIterator;
+  using Iterator = ConstIterator;
+  using NodeHandle = typename Table::NodeHandle;
+
   UnorderedSet() = default;
   explicit UnorderedSet(size_t count);
 
@@ -23,189 +73,281 @@ class UnorderedSet {
   bool Empty() const;
   void Clear();
 
-  bool Insert(const KeyT&);
-  bool Insert(KeyT&&);
+  std::pair<Iterator, bool> Insert(const KeyT&);
+  std::pair<Iterator, bool> Insert(KeyT&&);
   void Erase(const KeyT&);
+  template <class K, class = EnableIfTransparent<K>>
+  void Erase(const K&);
   bool Find(const KeyT&) const;
+  template <class K, class = EnableIfTransparent<K>>
+  bool Find(const K&) const;
+
+  // Вставка и поиск пачками с предвыборкой корзин в кэш, для больших таблиц, не помещающихся в кэш.
+  // InsertBatch один раз расширяет таблицу под весь диапазон; found[i] - есть ли keys[i]
+  template <class ForwardIterator>
+  void InsertBatch(ForwardIterator begin, ForwardIterator end);
+  void FindBatch(const KeyT* keys, size_t count, bool* found) const;
+  template <class K, class = EnableIfTransparent<K>>
+  void FindBatch(const K* keys, size_t count, bool* found) const;
+
+  // Извлеченный ключ вставляется в другое множество того же типа без копирования;
+  // для ChainedLayout узел списка переходит целиком, без выделения памяти
+  NodeHandle Extract(const KeyT&);
+  template <class K, class = EnableIfTransparent<K>>
+  NodeHandle Extract(const K&);
+  std::pair<Iterator, bool> Insert(NodeHandle&& node);
+
+  // Переносит ключи other, которых здесь нет, остальные остаются в other. Место резервируется один раз
+  void Merge(UnorderedSet& other);
+  void Merge(UnorderedSet&& other);
+
+  // Передает все ключи в func перемещением и оставляет множество пустым
+  template <class Function>
+  void Drain(Function func);
 
   void Rehash(size_t new_bucket_count);
   void Reserve(size_t new_bucket_count);
 
+  Iterator begin() const;  // NOLINT
+  Iterator end() const;  // NOLINT
+  ConstIterator cbegin() const;  // NOLINT
+  ConstIterator cend() const;  // NOLINT
+
   size_t BucketCount() const;
   size_t BucketSize(size_t id) const;
-  size_t Bucket(KeyT key) const;
+  size_t Bucket(const KeyT& key) const;
+  template <class K, class = EnableIfTransparent<K>>
+  size_t Bucket(const K& key) const;
   double LoadFactor() const;
 
+  // Только для FlatLayout и тривиально копируемых ключей: пишет таблицу как есть,
+  // такой файл открывается MappedUnorderedSet из snapshot.h без перестроения
+  void WriteSnapshot(std::ostream& out) const;
+
+#if UNORDERED_SET_STATS
+  // Счетчики таблицы и распределение текущих ключей; JSON - одна строка без перевода строки в конце
+  const TableStats& Stats() const;
+  void WriteStatsJson(std::ostream& out) const;
+#endif
+
  private:
-  std::vector<std::list<KeyT>> keys_ = {};
-  size_t count_elements_ = 0;
+  Table table_ = {};
 };
 
 // Конструкторы
-template <class KeyT>
-UnorderedSet<KeyT>::UnorderedSet(size_t count) : keys_(count) {
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::UnorderedSet(size_t count) : table_(count) {
 }
 
-template <class KeyT>
+template <class KeyT, class Layout, class Hash, class KeyEqual>
 template <class ForwardIterator>
-UnorderedSet<KeyT>::UnorderedSet(ForwardIterator begin, ForwardIterator end) : keys_(std::distance(begin, end)) {
-  count_elements_ = std::distance(begin, end);
-  for (; begin != end; ++begin) {
-    size_t bucket_index = std::hash<KeyT>{}(*begin) % count_elements_;
-    keys_[bucket_index].push_back(*begin);
-  }
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::UnorderedSet(ForwardIterator begin, ForwardIterator end) {
+  table_.InsertBatch(begin, end);
 }
 
-template <class KeyT>
-UnorderedSet<KeyT>::UnorderedSet(const UnorderedSet& other)
-    : keys_(other.keys_), count_elements_(other.count_elements_) {
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::UnorderedSet(const UnorderedSet& other) : table_(other.table_) {
 }
 
-template <class KeyT>
-UnorderedSet<KeyT>::UnorderedSet(UnorderedSet&& other) noexcept
-    : keys_(other.keys_), count_elements_(other.count_elements_) {
-  other.keys_ = {};
-  other.count_elements_ = 0;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::UnorderedSet(UnorderedSet&& other) noexcept : table_(std::move(other.table_)) {
+  other.table_.Clear();
 }
 
 // Присваивание
-template <class KeyT>
-UnorderedSet<KeyT>& UnorderedSet<KeyT>::operator=(const UnorderedSet& other) {
-  keys_ = other.keys_;
-  count_elements_ = other.count_elements_;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>& UnorderedSet<KeyT, Layout, Hash, KeyEqual>::operator=(const UnorderedSet& other) {
+  table_ = other.table_;
   return *this;
 }
 
-template <class KeyT>
-UnorderedSet<KeyT>& UnorderedSet<KeyT>::operator=(UnorderedSet&& other) noexcept {
-  keys_ = other.keys_;
-  count_elements_ = other.count_elements_;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>& UnorderedSet<KeyT, Layout, Hash, KeyEqual>::operator=(UnorderedSet&& other) noexcept {
+  table_ = std::move(other.table_);
   other.Clear();
   return *this;
 }
 
 // Методы
-template <class KeyT>
-size_t UnorderedSet<KeyT>::Size() const {
-  return count_elements_;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Size() const {
+  return table_.Size();
 }
 
-template <class KeyT>
-bool UnorderedSet<KeyT>::Empty() const {
-  return count_elements_ == 0;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+bool UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Empty() const {
+  return table_.Size() == 0;
 }
 
-template <class KeyT>
-void UnorderedSet<KeyT>::Clear() {
-  count_elements_ = 0;
-  keys_ = {};
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Clear() {
+  table_.Clear();
 }
 
-template <class KeyT>
-void UnorderedSet<KeyT>::Erase(const KeyT& key) {
-  size_t bucket_index = Bucket(key);
-  if (keys_[bucket_index].empty()) {
-    return;
-  }
-  auto it = std::find(keys_[bucket_index].begin(), keys_[bucket_index].end(), key);
-  keys_[bucket_index].erase(it);
-  count_elements_ -= 1;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Erase(const KeyT& key) {
+  table_.Erase(key);
 }
 
-template <class KeyT>
-bool UnorderedSet<KeyT>::Find(const KeyT& key) const {
-  if (keys_.empty()) {
-    return false;
-  }
-  size_t bucket_index = Bucket(key);
-  if (keys_[bucket_index].empty()) {
-    return false;
-  }
-  auto it = std::find(keys_[bucket_index].begin(), keys_[bucket_index].end(), key);
-  return it != keys_[bucket_index].end();
-}
-
-template <class KeyT>
-void UnorderedSet<KeyT>::Rehash(size_t new_bucket_count) {
-  if (new_bucket_count != keys_.size() && new_bucket_count >= count_elements_) {
-    std::vector<std::list<KeyT>> new_table(new_bucket_count);
-    for (size_t i = 0; i < keys_.size(); i++) {
-      for (auto& el : keys_[i]) {
-        size_t bucket_index = std::hash<KeyT>{}(el) % new_bucket_count;
-        new_table[bucket_index].push_back(std::move(el));
-      }
-    }
-    keys_ = std::move(new_table);
-  }
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Erase(const K& key) {
+  table_.Erase(key);
 }
 
-template <class KeyT>
-void UnorderedSet<KeyT>::Reserve(size_t new_bucket_count) {
-  if (new_bucket_count > keys_.size()) {
-    this->Rehash(new_bucket_count);
-  }
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+bool UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Find(const KeyT& key) const {
+  return table_.Find(key) != table_.end();
 }
 
-template <class KeyT>
-bool UnorderedSet<KeyT>::Insert(const KeyT& key) {
-  if (this->BucketCount() == 0) {
-    keys_.resize(1);
-  }
-  if (Find(key)) {
-    return false;
-  }
-  if (this->LoadFactor() >= 1) {
-    this->Rehash(BucketCount() * 2);
-  }
-  size_t bucket_index = Bucket(key);
-  keys_[bucket_index].push_back(std::move(key));
-  count_elements_ += 1;
-  return true;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+bool UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Find(const K& key) const {
+  return table_.Find(key) != table_.end();
 }
 
-template <class KeyT>
-bool UnorderedSet<KeyT>::Insert(KeyT&& key) {
-  if (this->BucketCount() == 0) {
-    keys_.resize(1);
-  }
-  if (Find(key)) {
-    return false;
-  }
-  if (this->LoadFactor() >= 1) {
-    this->Rehash(BucketCount() * 2);
-  }
-  size_t bucket_index = Bucket(key);
-  keys_[bucket_index].push_back(std::move(key));
-  count_elements_ += 1;
-  return true;
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Rehash(size_t new_bucket_count) {
+  table_.Rehash(new_bucket_count);
 }
 
-template <class KeyT>
-size_t UnorderedSet<KeyT>::BucketCount() const {
-  return keys_.size();
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Reserve(size_t new_bucket_count) {
+  table_.Reserve(new_bucket_count);
 }
 
-template <class KeyT>
-size_t UnorderedSet<KeyT>::BucketSize(size_t id) const {
-  if (count_elements_ == 0 || id > keys_.size() - 1) {
-    return 0;
-  }
-  return keys_[id].size();
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+std::pair<typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Insert(const KeyT& key) {
+  return table_.Emplace(key, key);
 }
 
-template <class KeyT>
-size_t UnorderedSet<KeyT>::Bucket(KeyT key) const {
-  if (keys_.empty()) {
-    return 0;
-  }
-  return std::hash<KeyT>{}(key) % keys_.size();
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+std::pair<typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Insert(KeyT&& key) {
+  return table_.Emplace(key, std::move(key));
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class ForwardIterator>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::InsertBatch(ForwardIterator begin, ForwardIterator end) {
+  table_.InsertBatch(begin, end);
 }
 
-template <class KeyT>
-double UnorderedSet<KeyT>::LoadFactor() const {
-  if (count_elements_ == 0) {
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::FindBatch(const KeyT* keys, size_t count, bool* found) const {
+  table_.FindBatch(keys, count, found);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::FindBatch(const K* keys, size_t count, bool* found) const {
+  table_.FindBatch(keys, count, found);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::NodeHandle UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Extract(
+    const KeyT& key) {
+  return table_.Extract(key);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::NodeHandle UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Extract(
+    const K& key) {
+  return table_.Extract(key);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+std::pair<typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Iterator, bool>
+UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Insert(NodeHandle&& node) {
+  return table_.Insert(std::move(node));
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Merge(UnorderedSet& other) {
+  table_.Merge(other.table_);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Merge(UnorderedSet&& other) {
+  table_.Merge(other.table_);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class Function>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Drain(Function func) {
+  table_.Drain(func);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::WriteSnapshot(std::ostream& out) const {
+  table_.WriteSnapshot(out);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t UnorderedSet<KeyT, Layout, Hash, KeyEqual>::BucketCount() const {
+  return table_.BucketCount();
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t UnorderedSet<KeyT, Layout, Hash, KeyEqual>::BucketSize(size_t id) const {
+  return table_.BucketSize(id);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+size_t UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Bucket(const KeyT& key) const {
+  return table_.Bucket(key);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+template <class K, class>
+size_t UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Bucket(const K& key) const {
+  return table_.Bucket(key);
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+double UnorderedSet<KeyT, Layout, Hash, KeyEqual>::LoadFactor() const {
+  if (table_.Size() == 0) {
     return 0;
   }
-  return 1.0 * count_elements_ / keys_.size();
+  return 1.0 * table_.Size() / table_.BucketCount();
+}
+
+#if UNORDERED_SET_STATS
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+const TableStats& UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Stats() const {
+  return table_.Stats();
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+void UnorderedSet<KeyT, Layout, Hash, KeyEqual>::WriteStatsJson(std::ostream& out) const {
+  table_.WriteStatsJson(out);
+}
+#endif
+
+// Итераторы
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Iterator UnorderedSet<KeyT, Layout, Hash, KeyEqual>::begin()
+    const {  // NOLINT
+  return table_.begin();
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::Iterator UnorderedSet<KeyT, Layout, Hash, KeyEqual>::end()
+    const {  // NOLINT
+  return table_.end();
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::ConstIterator UnorderedSet<KeyT, Layout, Hash, KeyEqual>::cbegin()
+    const {  // NOLINT
+  return table_.begin();
+}
+
+template <class KeyT, class Layout, class Hash, class KeyEqual>
+typename UnorderedSet<KeyT, Layout, Hash, KeyEqual>::ConstIterator UnorderedSet<KeyT, Layout, Hash, KeyEqual>::cend()
+    const {  // NOLINT
+  return table_.end();
 }
 #endif  // UNORDERED_SET_H
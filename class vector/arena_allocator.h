@@ -0,0 +1,125 @@
+#ifndef ARENA_ALLOCATOR_H
+#define ARENA_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Монотонная арена: память выдается сдвигом указателя внутри блоков и освобождается только целиком
+class MonotonicArena {
+ public:
+  explicit MonotonicArena(size_t block_size = 64 * 1024);
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+  void* Allocate(size_t bytes, size_t alignment);
+  void Release();
+  size_t BytesAllocated() const;
+
+  ~MonotonicArena();
+
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+
+  void AddBlock(size_t min_bytes);
+
+  Block* head_ = nullptr;
+  char* current_ = nullptr;
+  char* end_ = nullptr;
+  size_t block_size_;
+  size_t bytes_allocated_ = 0;
+};
+
+// Аллокатор поверх арены, deallocate ничего не делает
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T; // NOLINT
+  // Как у std::pmr::polymorphic_allocator: при присваивании и обмене контейнер остается в своей арене,
+  // а элементы копируются или переносятся в нее, иначе долгоживущий вектор унаследовал бы арену запроса
+  using propagate_on_container_copy_assignment = std::false_type; // NOLINT
+  using propagate_on_container_move_assignment = std::false_type; // NOLINT
+  using propagate_on_container_swap = std::false_type; // NOLINT
+
+  explicit ArenaAllocator(MonotonicArena& arena) : arena_(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) : arena_(other.Arena()) {}  // NOLINT
+
+  T* allocate(size_t count) {  // NOLINT
+    return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+  }
+  void deallocate(T*, size_t) {  // NOLINT
+  }
+
+  MonotonicArena* Arena() const {
+    return arena_;
+  }
+
+  template <typename U>
+  friend bool operator==(const ArenaAllocator& first, const ArenaAllocator<U>& second) {
+    return first.arena_ == second.Arena();
+  }
+  template <typename U>
+  friend bool operator!=(const ArenaAllocator& first, const ArenaAllocator<U>& second) {
+    return !(first == second);
+  }
+
+ private:
+  MonotonicArena* arena_;
+};
+
+// Конструкторы
+inline MonotonicArena::MonotonicArena(size_t block_size) : block_size_(block_size) {
+}
+
+// Методы
+inline void MonotonicArena::AddBlock(size_t min_bytes) {
+  size_t size = block_size_ > min_bytes ? block_size_ : min_bytes;
+  auto block = static_cast<Block*>(::operator new(sizeof(Block) + size));
+  block->next = head_;
+  block->size = size;
+  head_ = block;
+  current_ = reinterpret_cast<char*>(block + 1);
+  end_ = current_ + size;
+}
+
+inline void* MonotonicArena::Allocate(size_t bytes, size_t alignment) {
+  auto aligned = [&] {
+    auto address = reinterpret_cast<uintptr_t>(current_);
+    return reinterpret_cast<char*>((address + alignment - 1) & ~(alignment - 1));
+  };
+  char* result = aligned();
+  if (current_ == nullptr || result + bytes > end_) {
+    AddBlock(bytes + alignment);
+    result = aligned();
+  }
+  current_ = result + bytes;
+  bytes_allocated_ += bytes;
+  return result;
+}
+
+inline void MonotonicArena::Release() {
+  while (head_ != nullptr) {
+    Block* next = head_->next;
+    ::operator delete(head_);
+    head_ = next;
+  }
+  current_ = nullptr;
+  end_ = nullptr;
+  bytes_allocated_ = 0;
+}
+
+inline size_t MonotonicArena::BytesAllocated() const {
+  return bytes_allocated_;
+}
+
+// Деструктор
+inline MonotonicArena::~MonotonicArena() {
+  Release();
+}
+
+#endif  // ARENA_ALLOCATOR_H
@@ -0,0 +1,290 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+// Вектор только на добавление для нескольких потоков-писателей. PushBack занимает индекс одним fetch_add,
+// хранилище состоит из сегментов длины kFirstSegment, 2 * kFirstSegment, 4 * kFirstSegment, ...,
+// поэтому элементы никогда не перемещаются. Элемент становится видимым читателям после того, как
+// писатель выставит флаг публикации; чтение опубликованного элемента wait-free. PushBack lock-free:
+// сегменты ставятся через compare_exchange, и ни один поток не ждет другой
+template <typename T, size_t kFirstSegment = 64>
+class ConcurrentVector {
+  static_assert(kFirstSegment > 0 && (kFirstSegment & (kFirstSegment - 1)) == 0,
+                "kFirstSegment must be a power of two");
+
+public:
+  using ValueType = T;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using SizeType = size_t;
+
+  // Конструкторы
+  ConcurrentVector() = default;
+  explicit ConcurrentVector(SizeType capacity);
+  ConcurrentVector(const ConcurrentVector&) = delete;
+  ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+  // Методы
+  // Возвращают индекс добавленного элемента
+  SizeType PushBack(ConstReference value);
+  SizeType PushBack(ValueType&& value);
+  template <class... Args>
+  SizeType EmplaceBack(Args&&... args);
+
+  // Заранее выделяет сегменты под первые new_cap элементов, можно вызывать параллельно с PushBack
+  void Reserve(SizeType new_cap);
+
+  // Число занятых индексов: часть из них может еще конструироваться
+  [[nodiscard]] SizeType Size() const;
+  [[nodiscard]] bool Empty() const;
+  [[nodiscard]] bool IsPublished(SizeType ind) const;
+
+  // nullptr, если элемент с таким индексом еще не опубликован
+  ConstPointer TryGet(SizeType ind) const;
+  Pointer TryGet(SizeType ind);
+
+  // Только для опубликованных элементов, например для индексов, которые вернул PushBack
+  ConstReference operator[](SizeType ind) const;
+  Reference operator[](SizeType ind);
+
+  ConstReference At(SizeType ind) const;
+  Reference At(SizeType ind);
+
+  // Обходит опубликованные элементы по возрастанию индекса, пропуская еще не готовые
+  template <class Function>
+  void ForEach(Function func) const;
+
+  // Деструктор
+  ~ConcurrentVector();
+
+private:
+  struct Slot {
+    alignas(T) unsigned char storage[sizeof(T)];
+    std::atomic<bool> published{false};
+  };
+
+  static constexpr SizeType Log2(SizeType value) {
+    SizeType result = 0;
+    while (value > 1) {
+      value >>= 1;
+      ++result;
+    }
+    return result;
+  }
+
+  static constexpr SizeType kFirstShift = Log2(kFirstSegment);
+  static constexpr SizeType kMaxSegments = sizeof(SizeType) * 8 - kFirstShift;
+
+  // Сегмент k хранит индексы [kFirstSegment * (2^k - 1), kFirstSegment * (2^(k + 1) - 1))
+  static SizeType SegmentOf(SizeType ind);
+  static SizeType SegmentStart(SizeType segment);
+  static SizeType SegmentSize(SizeType segment);
+  static Pointer Element(Slot& slot);
+
+  Slot* FindSlot(SizeType ind) const;
+  Slot* EnsureSegment(SizeType segment);
+
+  std::atomic<Slot*> segments_[kMaxSegments] = {};
+  std::atomic<SizeType> size_{0};
+};
+
+// Конструкторы
+template <typename T, size_t kFirstSegment>
+ConcurrentVector<T, kFirstSegment>::ConcurrentVector(SizeType capacity) {
+  Reserve(capacity);
+}
+
+// Работа с памятью
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::SegmentOf(SizeType ind) {
+  return static_cast<SizeType>(sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(ind + kFirstSegment)) - kFirstShift;
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::SegmentStart(
+    SizeType segment) {
+  return kFirstSegment * ((SizeType{1} << segment) - 1);
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::SegmentSize(
+    SizeType segment) {
+  return kFirstSegment << segment;
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::Pointer ConcurrentVector<T, kFirstSegment>::Element(Slot& slot) {
+  return std::launder(reinterpret_cast<Pointer>(slot.storage));
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::Slot* ConcurrentVector<T, kFirstSegment>::FindSlot(SizeType ind) const {
+  SizeType segment = SegmentOf(ind);
+  Slot* slots = segments_[segment].load(std::memory_order_acquire);
+  return slots == nullptr ? nullptr : slots + (ind - SegmentStart(segment));
+}
+
+// Сегмент ставится одной compare_exchange: если его одновременно выделили несколько потоков,
+// проигравшие освобождают свою копию, и никто никого не ждет
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::Slot* ConcurrentVector<T, kFirstSegment>::EnsureSegment(
+    SizeType segment) {
+  Slot* slots = segments_[segment].load(std::memory_order_acquire);
+  if (slots != nullptr) {
+    return slots;
+  }
+  Slot* fresh = new Slot[SegmentSize(segment)];
+  if (segments_[segment].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire)) {
+    return fresh;
+  }
+  delete[] fresh;
+  return slots;
+}
+
+// Методы
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::PushBack(
+    ConstReference value) {
+  return EmplaceBack(value);
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::PushBack(
+    ValueType&& value) {
+  return EmplaceBack(std::move(value));
+}
+
+// Если конструктор или выделение сегмента бросит исключение, индекс останется занятым, но никогда не будет
+// опубликован. Поток, занявший первый индекс сегмента, заранее выделяет следующий: пока заполняется текущий,
+// остальным писателям почти не приходится выделять сегмент наперегонки и выбрасывать лишние копии
+template <typename T, size_t kFirstSegment>
+template <class... Args>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::EmplaceBack(
+    Args&&... args) {
+  SizeType ind = size_.fetch_add(1, std::memory_order_relaxed);
+  SizeType segment = SegmentOf(ind);
+  Slot& slot = EnsureSegment(segment)[ind - SegmentStart(segment)];
+  if (ind == SegmentStart(segment) && segment + 1 < kMaxSegments) {
+    EnsureSegment(segment + 1);
+  }
+  ::new (static_cast<void*>(slot.storage)) T(std::forward<Args>(args)...);
+  slot.published.store(true, std::memory_order_release);
+  return ind;
+}
+
+template <typename T, size_t kFirstSegment> void ConcurrentVector<T, kFirstSegment>::Reserve(SizeType new_cap) {
+  if (new_cap == 0) {
+    return;
+  }
+  for (SizeType segment = 0; segment <= SegmentOf(new_cap - 1); ++segment) {
+    EnsureSegment(segment);
+  }
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::SizeType ConcurrentVector<T, kFirstSegment>::Size() const {
+  return size_.load(std::memory_order_acquire);
+}
+
+template <typename T, size_t kFirstSegment> bool ConcurrentVector<T, kFirstSegment>::Empty() const {
+  return Size() == 0;
+}
+
+template <typename T, size_t kFirstSegment> bool ConcurrentVector<T, kFirstSegment>::IsPublished(SizeType ind) const {
+  return TryGet(ind) != nullptr;
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::ConstPointer ConcurrentVector<T, kFirstSegment>::TryGet(
+    SizeType ind) const {
+  if (ind >= Size()) {
+    return nullptr;
+  }
+  Slot* slot = FindSlot(ind);
+  if (slot == nullptr || !slot->published.load(std::memory_order_acquire)) {
+    return nullptr;
+  }
+  return Element(*slot);
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::Pointer ConcurrentVector<T, kFirstSegment>::TryGet(SizeType ind) {
+  return const_cast<Pointer>(static_cast<const ConcurrentVector&>(*this).TryGet(ind));
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::ConstReference ConcurrentVector<T, kFirstSegment>::operator[](
+    SizeType ind) const {
+  return *Element(*FindSlot(ind));
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::Reference ConcurrentVector<T, kFirstSegment>::operator[](SizeType ind) {
+  return *Element(*FindSlot(ind));
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::ConstReference ConcurrentVector<T, kFirstSegment>::At(
+    SizeType ind) const {
+  ConstPointer element = TryGet(ind);
+  if (element == nullptr) {
+    throw std::out_of_range("Index out of range");
+  }
+  return *element;
+}
+
+template <typename T, size_t kFirstSegment>
+typename ConcurrentVector<T, kFirstSegment>::Reference ConcurrentVector<T, kFirstSegment>::At(SizeType ind) {
+  Pointer element = TryGet(ind);
+  if (element == nullptr) {
+    throw std::out_of_range("Index out of range");
+  }
+  return *element;
+}
+
+template <typename T, size_t kFirstSegment>
+template <class Function>
+void ConcurrentVector<T, kFirstSegment>::ForEach(Function func) const {
+  SizeType size = Size();
+  for (SizeType segment = 0; segment < kMaxSegments && SegmentStart(segment) < size; ++segment) {
+    Slot* slots = segments_[segment].load(std::memory_order_acquire);
+    if (slots == nullptr) {
+      continue;
+    }
+    SizeType count = std::min(SegmentSize(segment), size - SegmentStart(segment));
+    for (SizeType i = 0; i < count; ++i) {
+      if (slots[i].published.load(std::memory_order_acquire)) {
+        func(static_cast<ConstReference>(*Element(slots[i])));
+      }
+    }
+  }
+}
+
+// Деструктор
+template <typename T, size_t kFirstSegment> ConcurrentVector<T, kFirstSegment>::~ConcurrentVector() {
+  for (auto& segment : segments_) {
+    Slot* slots = segment.load(std::memory_order_relaxed);
+    if (slots == nullptr) {
+      continue;
+    }
+    SizeType count = SegmentSize(&segment - segments_);
+    for (SizeType i = 0; i < count; ++i) {
+      if (slots[i].published.load(std::memory_order_relaxed)) {
+        std::destroy_at(Element(slots[i]));
+      }
+    }
+    delete[] slots;
+  }
+}
+
+#endif  // CONCURRENT_VECTOR_H
@@ -5,6 +5,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "iterator.h"
+
 template<typename T>
 class ConstIterator {
  public:
@@ -14,73 +16,127 @@ class ConstIterator {
   using pointer = const T*; // NOLINT
   using reference = const T&; // NOLINT
 
-  explicit ConstIterator(pointer ptr) : ptr_(ptr) {}
-  const T& operator*() const {
+  constexpr ConstIterator() noexcept = default;
+  constexpr explicit ConstIterator(pointer ptr) noexcept : ptr_(ptr) {}
+#if VECTOR_CHECKED_ITERATORS
+  ConstIterator(pointer ptr, IteratorSource<T> source) noexcept
+      : ptr_(ptr), source_(source), generation_(*source.generation) {}
+  ConstIterator(Iterator<T> other) noexcept  // NOLINT
+      : ptr_(other.ptr_), source_(other.source_), generation_(other.generation_) {}
+#else
+  constexpr ConstIterator(Iterator<T> other) noexcept : ptr_(other.ptr_) {}  // NOLINT
+#endif
+  constexpr const T& operator*() const noexcept {
+    CheckDereference();
     return *ptr_;
   }
-  const T* operator->() {
+  constexpr const T* operator->() const noexcept {
+    CheckDereference();
     return ptr_;
   }
-  ConstIterator& operator++() {
+  constexpr reference operator[](difference_type value) const noexcept {
+    return *(*this + value);
+  }
+  constexpr ConstIterator& operator++() noexcept {
     ++ptr_;
+    CheckPosition();
     return *this;
   }
-  const ConstIterator operator++(int) {
+  constexpr const ConstIterator operator++(int) noexcept {
     const ConstIterator helper = *this;
     ++(*this);
     return helper;
   }
-  ConstIterator& operator--() {
+  constexpr ConstIterator& operator--() noexcept {
     --ptr_;
+    CheckPosition();
     return *this;
   }
-  const ConstIterator operator--(int) {
+  constexpr const ConstIterator operator--(int) noexcept {
     const ConstIterator helper = *this;
     --(*this);
     return helper;
   }
-  friend bool operator==(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr bool operator==(const ConstIterator& first, const ConstIterator& second) noexcept {
     return first.ptr_ == second.ptr_;
   }
-  friend bool operator!=(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr bool operator!=(const ConstIterator& first, const ConstIterator& second) noexcept {
     return first.ptr_ != second.ptr_;
   }
-  friend bool operator>(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr bool operator>(const ConstIterator& first, const ConstIterator& second) noexcept {
     return first.ptr_ > second.ptr_;
   }
-  friend bool operator<(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr bool operator<(const ConstIterator& first, const ConstIterator& second) noexcept {
     return first.ptr_ < second.ptr_;
   }
-  friend bool operator>=(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr bool operator>=(const ConstIterator& first, const ConstIterator& second) noexcept {
     return first.ptr_ >= second.ptr_;
   }
-  friend bool operator<=(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr bool operator<=(const ConstIterator& first, const ConstIterator& second) noexcept {
     return first.ptr_ <= second.ptr_;
   }
-  friend difference_type operator-(const ConstIterator& first, const ConstIterator& second) {
+  friend constexpr difference_type operator-(const ConstIterator& first, const ConstIterator& second) noexcept {
     return (first.ptr_ - second.ptr_);
   }
-  friend ConstIterator operator+(const ConstIterator& iterator, const int64_t& value) {
-    Iterator result = iterator;
-    result.ptr_ += value;
+  friend constexpr ConstIterator operator+(const ConstIterator& iterator, difference_type value) noexcept {
+    ConstIterator result = iterator;
+    result += value;
     return result;
   }
-  friend ConstIterator operator-(const ConstIterator& iterator, const int64_t& value) {
-    Iterator result = iterator;
-    result.ptr_ -= value;
+  friend constexpr ConstIterator operator+(difference_type value, const ConstIterator& iterator) noexcept {
+    return iterator + value;
+  }
+  friend constexpr ConstIterator operator-(const ConstIterator& iterator, difference_type value) noexcept {
+    ConstIterator result = iterator;
+    result -= value;
     return result;
   }
-  ConstIterator &operator+=(const int64_t& value) {
+  constexpr ConstIterator &operator+=(difference_type value) noexcept {
     ptr_ += value;
+    CheckPosition();
     return *this;
   }
-  ConstIterator &operator-=(const int64_t& value) {
+  constexpr ConstIterator &operator-=(difference_type value) noexcept {
     ptr_ -= value;
+    CheckPosition();
     return *this;
   }
 
  private:
-  pointer ptr_;
+  // Те же проверки, что и в Iterator
+  constexpr void CheckDereference() const noexcept {
+#if VECTOR_CHECKED_ITERATORS
+    if (source_.data != nullptr) {
+      CheckGeneration();
+      if (ptr_ < *source_.data || ptr_ >= *source_.data + *source_.size) {
+        IteratorCheckFailed("dereference out of range");
+      }
+    }
+#endif
+  }
+  constexpr void CheckPosition() const noexcept {
+#if VECTOR_CHECKED_ITERATORS
+    if (source_.data != nullptr) {
+      CheckGeneration();
+      if (ptr_ < *source_.data || ptr_ > *source_.data + *source_.size) {
+        IteratorCheckFailed("iterator moved out of range");
+      }
+    }
+#endif
+  }
+#if VECTOR_CHECKED_ITERATORS
+  void CheckGeneration() const noexcept {
+    if (*source_.generation != generation_) {
+      IteratorCheckFailed("iterator used after reallocation");
+    }
+  }
+#endif
+
+  pointer ptr_ = nullptr;
+#if VECTOR_CHECKED_ITERATORS
+  IteratorSource<T> source_;
+  size_t generation_ = 0;
+#endif
 };
 
-#endif
\ No newline at end of file
+#endif
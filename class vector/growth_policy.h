@@ -0,0 +1,46 @@
+#ifndef GROWTH_POLICY_H
+#define GROWTH_POLICY_H
+
+#include <algorithm>
+#include <cstddef>
+
+// Политики роста для Vector: Grow(capacity, element_size) возвращает новую вместимость больше capacity.
+// Своя политика - любой тип с такой же статической функцией; если она вернет не больше capacity,
+// Vector все равно вырастет хотя бы на один элемент
+struct DoublingGrowth {
+  static size_t Grow(size_t capacity, size_t) {
+    return capacity > 0 ? capacity * 2 : 1;
+  }
+};
+
+struct OneAndHalfGrowth {
+  static size_t Grow(size_t capacity, size_t) {
+    return capacity > 1 ? capacity + capacity / 2 : capacity + 1;
+  }
+};
+
+struct PowerOfTwoGrowth {
+  static size_t Grow(size_t capacity, size_t) {
+    size_t result = 1;
+    while (result <= capacity) {
+      result *= 2;
+    }
+    return result;
+  }
+};
+
+// До kThreshold байт удваивает, дальше растет в 1.5 раза с округлением размера буфера до целых страниц.
+// Для элементов больше страницы округление может съесть весь рост, поэтому добавляется хотя бы один элемент
+template <size_t kPageSize = 4096, size_t kThreshold = 1 << 20>
+struct PageMultipleGrowth {
+  static size_t Grow(size_t capacity, size_t element_size) {
+    if (capacity * element_size < kThreshold) {
+      return DoublingGrowth::Grow(capacity, element_size);
+    }
+    size_t bytes = (capacity + capacity / 2) * element_size;
+    bytes = (bytes + kPageSize - 1) / kPageSize * kPageSize;
+    return std::max(bytes / element_size, capacity + 1);
+  }
+};
+
+#endif  // GROWTH_POLICY_H
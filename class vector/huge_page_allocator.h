@@ -0,0 +1,120 @@
+#ifndef HUGE_PAGE_ALLOCATOR_H
+#define HUGE_PAGE_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Размещение страниц большого буфера по узлам NUMA
+enum class NumaPlacement {
+  kFirstTouch,  // страница попадает на узел потока, который первым к ней обратился (поведение ядра по умолчанию)
+  kInterleave,  // страницы раскладываются по всем узлам по очереди
+};
+
+// Аллокатор для больших буферов Vector: начиная с kHugePageSize байт память берется через mmap,
+// выравнивается на 2 МБ и помечается MADV_HUGEPAGE. Маленькие буферы идут через operator new.
+// Вне Linux всегда используется operator new
+template <typename T, NumaPlacement kPlacement = NumaPlacement::kFirstTouch>
+class HugePageAllocator {
+ public:
+  using value_type = T; // NOLINT
+  using is_always_equal = std::true_type; // NOLINT
+
+  template <typename U>
+  struct rebind {  // NOLINT
+    using other = HugePageAllocator<U, kPlacement>; // NOLINT
+  };
+
+  static constexpr size_t kHugePageSize = size_t(2) << 20;
+
+  HugePageAllocator() = default;
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U, kPlacement>&) {}  // NOLINT
+
+  T* allocate(size_t count);  // NOLINT
+  void deallocate(T* ptr, size_t count) noexcept;  // NOLINT
+
+  template <typename U>
+  friend bool operator==(const HugePageAllocator&, const HugePageAllocator<U, kPlacement>&) {
+    return true;
+  }
+  template <typename U>
+  friend bool operator!=(const HugePageAllocator&, const HugePageAllocator<U, kPlacement>&) {
+    return false;
+  }
+
+ private:
+  static size_t MappedLength(size_t bytes);
+  static void* MapHuge(size_t length);
+};
+
+// Методы
+template <typename T, NumaPlacement kPlacement>
+size_t HugePageAllocator<T, kPlacement>::MappedLength(size_t bytes) {
+  return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+template <typename T, NumaPlacement kPlacement>
+void* HugePageAllocator<T, kPlacement>::MapHuge(size_t length) {
+#ifdef __linux__
+  // Лишние 2 МБ нужны, чтобы отрезать невыровненные края и получить адрес, кратный размеру огромной страницы
+  size_t reserved = length + kHugePageSize;
+  void* raw = mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  auto begin = reinterpret_cast<uintptr_t>(raw);
+  uintptr_t aligned = (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+  if (aligned != begin) {
+    munmap(raw, aligned - begin);
+  }
+  size_t tail = begin + reserved - (aligned + length);
+  if (tail != 0) {
+    munmap(reinterpret_cast<void*>(aligned + length), tail);
+  }
+  auto ptr = reinterpret_cast<void*>(aligned);
+  madvise(ptr, length, MADV_HUGEPAGE);
+  if constexpr (kPlacement == NumaPlacement::kInterleave) {
+    // Ядро пересекает маску с доступными узлами, поэтому можно передать все биты. Ошибку игнорируем:
+    // без NUMA память просто остается на единственном узле
+    unsigned long nodemask = ~0UL;
+    syscall(SYS_mbind, ptr, length, MPOL_INTERLEAVE, &nodemask, sizeof(nodemask) * 8, 0);
+  }
+  return ptr;
+#else
+  return ::operator new(length);
+#endif
+}
+
+template <typename T, NumaPlacement kPlacement>
+T* HugePageAllocator<T, kPlacement>::allocate(size_t count) {  // NOLINT
+  size_t bytes = count * sizeof(T);
+  if (bytes < kHugePageSize) {
+    return static_cast<T*>(::operator new(bytes, std::align_val_t(alignof(T))));
+  }
+  return static_cast<T*>(MapHuge(MappedLength(bytes)));
+}
+
+template <typename T, NumaPlacement kPlacement>
+void HugePageAllocator<T, kPlacement>::deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+  size_t bytes = count * sizeof(T);
+  if (bytes < kHugePageSize) {
+    ::operator delete(ptr, std::align_val_t(alignof(T)));
+    return;
+  }
+#ifdef __linux__
+  munmap(ptr, MappedLength(bytes));
+#else
+  ::operator delete(ptr);
+#endif
+}
+
+#endif  // HUGE_PAGE_ALLOCATOR_H
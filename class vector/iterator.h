@@ -4,6 +4,34 @@
 #include <iterator>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Проверяемые итераторы: по умолчанию включены в отладочной сборке и выключены при NDEBUG.
+// Без проверок итератор - это только указатель, все операции constexpr и noexcept
+#ifndef VECTOR_CHECKED_ITERATORS
+#ifdef NDEBUG
+#define VECTOR_CHECKED_ITERATORS 0
+#else
+#define VECTOR_CHECKED_ITERATORS 1
+#endif
+#endif
+
+#if VECTOR_CHECKED_ITERATORS
+// Откуда проверяемый итератор узнает текущее состояние контейнера: буфер, размер и поколение буфера,
+// которое контейнер увеличивает при каждой смене буфера
+template <typename T>
+struct IteratorSource {
+  const T* const* data = nullptr;
+  const size_t* size = nullptr;
+  const size_t* generation = nullptr;
+};
+
+[[noreturn]] inline void IteratorCheckFailed(const char* message) noexcept {
+  std::fprintf(stderr, "Iterator check failed: %s\n", message);
+  std::abort();
+}
+#endif
 
 template<typename T>
 class Iterator {
@@ -14,73 +42,127 @@ class Iterator {
   using pointer = T*; // NOLINT
   using reference = T&; // NOLINT
 
-  explicit Iterator(pointer ptr) : ptr_(ptr) {}
-  reference operator*() const {
+  constexpr Iterator() noexcept = default;
+  constexpr explicit Iterator(pointer ptr) noexcept : ptr_(ptr) {}
+#if VECTOR_CHECKED_ITERATORS
+  Iterator(pointer ptr, IteratorSource<T> source) noexcept
+      : ptr_(ptr), source_(source), generation_(*source.generation) {}
+#endif
+  constexpr reference operator*() const noexcept {
+    CheckDereference();
     return *ptr_;
   }
-  pointer operator->() {
+  constexpr pointer operator->() const noexcept {
+    CheckDereference();
     return ptr_;
   }
-  Iterator& operator++() {
+  constexpr reference operator[](difference_type value) const noexcept {
+    return *(*this + value);
+  }
+  constexpr Iterator& operator++() noexcept {
     ++ptr_;
+    CheckPosition();
     return *this;
   }
-  const Iterator operator++(int) {
+  constexpr const Iterator operator++(int) noexcept {
     const Iterator helper = *this;
     ++(*this);
     return helper;
   }
-  Iterator& operator--() {
+  constexpr Iterator& operator--() noexcept {
     --ptr_;
+    CheckPosition();
     return *this;
   }
-  const Iterator operator--(int) {
+  constexpr const Iterator operator--(int) noexcept {
     const Iterator helper = *this;
     --(*this);
     return helper;
   }
-  friend bool operator==(const Iterator& first, const Iterator& second) {
+  friend constexpr bool operator==(const Iterator& first, const Iterator& second) noexcept {
     return first.ptr_ == second.ptr_;
   }
-  friend bool operator!=(const Iterator& first, const Iterator& second) {
+  friend constexpr bool operator!=(const Iterator& first, const Iterator& second) noexcept {
     return first.ptr_ != second.ptr_;
   }
-  friend bool operator>(const Iterator& first, const Iterator& second) {
+  friend constexpr bool operator>(const Iterator& first, const Iterator& second) noexcept {
     return first.ptr_ > second.ptr_;
   }
-  friend bool operator<(const Iterator& first, const Iterator& second) {
+  friend constexpr bool operator<(const Iterator& first, const Iterator& second) noexcept {
     return first.ptr_ < second.ptr_;
   }
-  friend bool operator>=(const Iterator& first, const Iterator& second) {
+  friend constexpr bool operator>=(const Iterator& first, const Iterator& second) noexcept {
     return first.ptr_ >= second.ptr_;
   }
-  friend bool operator<=(const Iterator& first, const Iterator& second) {
+  friend constexpr bool operator<=(const Iterator& first, const Iterator& second) noexcept {
     return first.ptr_ <= second.ptr_;
   }
-  friend difference_type operator-(const Iterator& first, const Iterator& second) {
+  friend constexpr difference_type operator-(const Iterator& first, const Iterator& second) noexcept {
     return (first.ptr_ - second.ptr_);
   }
-  friend Iterator operator+(const Iterator& iterator, const int64_t& value) {
+  friend constexpr Iterator operator+(const Iterator& iterator, difference_type value) noexcept {
     Iterator result = iterator;
-    result.ptr_ += value;
+    result += value;
     return result;
   }
-  friend Iterator operator-(const Iterator& iterator, const int64_t& value) {
+  friend constexpr Iterator operator+(difference_type value, const Iterator& iterator) noexcept {
+    return iterator + value;
+  }
+  friend constexpr Iterator operator-(const Iterator& iterator, difference_type value) noexcept {
     Iterator result = iterator;
-    result.ptr_ -= value;
+    result -= value;
     return result;
   }
-  Iterator& operator+=(const int64_t value) {
+  constexpr Iterator& operator+=(difference_type value) noexcept {
     ptr_ += value;
+    CheckPosition();
     return *this;
   }
-  Iterator& operator-=(const int64_t value) {
+  constexpr Iterator& operator-=(difference_type value) noexcept {
     ptr_ -= value;
+    CheckPosition();
     return *this;
   }
 
  private:
-  pointer ptr_;
+  template <typename U>
+  friend class ConstIterator;
+
+  // Разыменовывать можно только элементы [begin, end) текущего буфера
+  constexpr void CheckDereference() const noexcept {
+#if VECTOR_CHECKED_ITERATORS
+    if (source_.data != nullptr) {
+      CheckGeneration();
+      if (ptr_ < *source_.data || ptr_ >= *source_.data + *source_.size) {
+        IteratorCheckFailed("dereference out of range");
+      }
+    }
+#endif
+  }
+  // Арифметика не должна уводить итератор за [begin, end]
+  constexpr void CheckPosition() const noexcept {
+#if VECTOR_CHECKED_ITERATORS
+    if (source_.data != nullptr) {
+      CheckGeneration();
+      if (ptr_ < *source_.data || ptr_ > *source_.data + *source_.size) {
+        IteratorCheckFailed("iterator moved out of range");
+      }
+    }
+#endif
+  }
+#if VECTOR_CHECKED_ITERATORS
+  void CheckGeneration() const noexcept {
+    if (*source_.generation != generation_) {
+      IteratorCheckFailed("iterator used after reallocation");
+    }
+  }
+#endif
+
+  pointer ptr_ = nullptr;
+#if VECTOR_CHECKED_ITERATORS
+  IteratorSource<T> source_;
+  size_t generation_ = 0;
+#endif
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,306 @@
+#ifndef MAPPED_VECTOR_H
+#define MAPPED_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "const_iterator.h"
+#include "iterator.h"
+
+class MappedVectorError : public std::runtime_error {
+public:
+  explicit MappedVectorError(const std::string& message) : std::runtime_error("MappedVectorError: " + message) {
+  }
+};
+
+// Заголовок файла, за ним с отступа kDataOffset лежат элементы подряд
+struct MappedVectorHeader {
+  static constexpr char kMagic[8] = {'M', 'A', 'P', 'V', 'E', 'C', 'T', 'R'};
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kDataOffset = 64;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t element_size;
+  uint32_t element_align;
+  uint32_t reserved;
+  uint64_t count;
+};
+
+enum class MapMode {
+  kReadOnly,     // элементы доступны только для чтения
+  kCopyOnWrite,  // изменения видны только этому процессу и не попадают в файл
+};
+
+// Массив тривиально копируемых T, отображенный из файла через mmap: открытие не читает данные,
+// страницы подгружаются при первом обращении. В режиме kReadOnly страницы защищены от записи,
+// поэтому все методы доступа, в том числе неконстантные, возвращают константные ссылки и указатели
+template <typename T, MapMode kMode = MapMode::kReadOnly>
+class MappedVector {
+  static constexpr bool kWritable = kMode == MapMode::kCopyOnWrite;
+
+  static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores elements as raw bytes");
+  static_assert(alignof(T) <= MappedVectorHeader::kDataOffset, "Element alignment is too large");
+
+public:
+  using ValueType = T;
+  using Pointer = std::conditional_t<kWritable, T*, const T*>;
+  using ConstPointer = const T*;
+  using Reference = std::conditional_t<kWritable, T&, const T&>;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = std::conditional_t<kWritable, ::Iterator<T>, ::ConstIterator<T>>;
+  using ConstIterator = ::ConstIterator<T>;
+
+  explicit MappedVector(const std::string& path);
+  MappedVector(const MappedVector&) = delete;
+  MappedVector(MappedVector&&) noexcept;
+
+  MappedVector& operator=(const MappedVector&) = delete;
+  MappedVector& operator=(MappedVector&&) noexcept;
+
+  // Записывает диапазон в файл в формате, который читает конструктор
+  template <class ForwardIterator>
+  static void Write(const std::string& path, ForwardIterator first, ForwardIterator last);
+
+  [[nodiscard]] SizeType Size() const;
+  [[nodiscard]] bool Empty() const;
+
+  ConstReference operator[](SizeType ind) const;
+  Reference operator[](SizeType ind);
+
+  ConstReference At(SizeType ind) const;
+  Reference At(SizeType ind);
+
+  ConstReference Front() const;
+  ConstReference Back() const;
+
+  Pointer Data();
+  ConstPointer Data() const;
+
+  Iterator begin();  // NOLINT
+  Iterator end(); // NOLINT
+
+  ConstIterator begin() const; // NOLINT
+  ConstIterator end() const; // NOLINT
+
+  ConstIterator cbegin() const; // NOLINT
+  ConstIterator cend() const; // NOLINT
+
+  ~MappedVector();
+
+private:
+  void Unmap() noexcept;
+
+  void* mapping_ = nullptr;
+  size_t mapping_size_ = 0;
+  Pointer arr_ = nullptr;
+  SizeType size_ = 0;
+};
+
+// Конструкторы
+template <typename T, MapMode kMode>
+MappedVector<T, kMode>::MappedVector(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw MappedVectorError("cannot open " + path);
+  }
+  struct stat info {};
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < MappedVectorHeader::kDataOffset) {
+    close(fd);
+    throw MappedVectorError(path + " is too short");
+  }
+  mapping_size_ = info.st_size;
+  int protection = kWritable ? PROT_READ | PROT_WRITE : PROT_READ;
+  mapping_ = mmap(nullptr, mapping_size_, protection, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapping_ == MAP_FAILED) {
+    mapping_ = nullptr;
+    throw MappedVectorError("cannot map " + path);
+  }
+
+  MappedVectorHeader header;
+  std::memcpy(&header, mapping_, sizeof(header));
+  const char* error = nullptr;
+  if (std::memcmp(header.magic, MappedVectorHeader::kMagic, sizeof(header.magic)) != 0) {
+    error = " is not a MappedVector file";
+  } else if (header.version != MappedVectorHeader::kVersion) {
+    error = " has unsupported version";
+  } else if (header.element_size != sizeof(T) || header.element_align != alignof(T)) {
+    error = " stores elements of another type";
+  } else if (header.count > (mapping_size_ - MappedVectorHeader::kDataOffset) / sizeof(T) ||
+             MappedVectorHeader::kDataOffset + header.count * sizeof(T) != mapping_size_) {
+    error = " has wrong size for its element count";
+  }
+  if (error != nullptr) {
+    Unmap();
+    throw MappedVectorError(path + error);
+  }
+  arr_ = reinterpret_cast<Pointer>(static_cast<char*>(mapping_) + MappedVectorHeader::kDataOffset);
+  size_ = header.count;
+}
+
+template <typename T, MapMode kMode>
+MappedVector<T, kMode>::MappedVector(MappedVector&& other) noexcept
+    : mapping_(other.mapping_), mapping_size_(other.mapping_size_), arr_(other.arr_), size_(other.size_) {
+  other.mapping_ = nullptr;
+  other.mapping_size_ = 0;
+  other.arr_ = nullptr;
+  other.size_ = 0;
+}
+
+// Присваивание
+template <typename T, MapMode kMode>
+MappedVector<T, kMode>& MappedVector<T, kMode>::operator=(MappedVector&& other) noexcept {
+  if (this != &other) {
+    Unmap();
+    mapping_ = other.mapping_;
+    mapping_size_ = other.mapping_size_;
+    arr_ = other.arr_;
+    size_ = other.size_;
+    other.mapping_ = nullptr;
+    other.mapping_size_ = 0;
+    other.arr_ = nullptr;
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+// Запись
+template <typename T, MapMode kMode>
+template <class ForwardIterator>
+void MappedVector<T, kMode>::Write(const std::string& path, ForwardIterator first, ForwardIterator last) {
+  MappedVectorHeader header{};
+  std::memcpy(header.magic, MappedVectorHeader::kMagic, sizeof(header.magic));
+  header.version = MappedVectorHeader::kVersion;
+  header.element_size = sizeof(T);
+  header.element_align = alignof(T);
+  header.count = std::distance(first, last);
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  char padding[MappedVectorHeader::kDataOffset] = {};
+  std::memcpy(padding, &header, sizeof(header));
+  out.write(padding, sizeof(padding));
+  for (; first != last; ++first) {
+    const T& value = *first;
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  if (!out) {
+    throw MappedVectorError("cannot write " + path);
+  }
+}
+
+// Методы
+template <typename T, MapMode kMode>
+void MappedVector<T, kMode>::Unmap() noexcept {
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+  }
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::SizeType MappedVector<T, kMode>::Size() const {
+  return size_;
+}
+
+template <typename T, MapMode kMode>
+bool MappedVector<T, kMode>::Empty() const {
+  return size_ == 0;
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstReference MappedVector<T, kMode>::operator[](SizeType ind) const {
+  return arr_[ind];
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::Reference MappedVector<T, kMode>::operator[](SizeType ind) {
+  return arr_[ind];
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstReference MappedVector<T, kMode>::At(SizeType ind) const {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return arr_[ind];
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::Reference MappedVector<T, kMode>::At(SizeType ind) {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return arr_[ind];
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstReference MappedVector<T, kMode>::Front() const {
+  return arr_[0];
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstReference MappedVector<T, kMode>::Back() const {
+  return arr_[size_ - 1];
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::Pointer MappedVector<T, kMode>::Data() {
+  return arr_;
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstPointer MappedVector<T, kMode>::Data() const {
+  return arr_;
+}
+
+// Итераторы
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::Iterator MappedVector<T, kMode>::begin() {  // NOLINT
+  return Iterator(arr_);
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::Iterator MappedVector<T, kMode>::end() {  // NOLINT
+  return Iterator(arr_ + size_);
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstIterator MappedVector<T, kMode>::begin() const {  // NOLINT
+  return ConstIterator(arr_);
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstIterator MappedVector<T, kMode>::end() const {  // NOLINT
+  return ConstIterator(arr_ + size_);
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstIterator MappedVector<T, kMode>::cbegin() const {  // NOLINT
+  return ConstIterator(arr_);
+}
+
+template <typename T, MapMode kMode>
+typename MappedVector<T, kMode>::ConstIterator MappedVector<T, kMode>::cend() const {  // NOLINT
+  return ConstIterator(arr_ + size_);
+}
+
+// Деструктор
+template <typename T, MapMode kMode>
+MappedVector<T, kMode>::~MappedVector() {
+  Unmap();
+}
+
+#endif  // MAPPED_VECTOR_H
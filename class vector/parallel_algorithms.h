@@ -0,0 +1,171 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "thread_pool.h"
+#include "vector.h"
+
+// Параллельные алгоритмы над парами итераторов произвольного доступа и над Vector.
+// Диапазон режется на чанки, длина которых кратна строке кэша, поэтому при выровненном
+// начале буфера разные потоки не пишут в одну строку
+constexpr size_t kParallelCacheLine = 64;
+constexpr size_t kParallelMinChunkBytes = 16 * 1024;
+
+// Длина чанка в элементах: около четырех чанков на поток, но не меньше kParallelMinChunkBytes
+template <typename T>
+size_t ParallelChunkSize(size_t count, const ThreadPool& pool) {
+  size_t per_line = sizeof(T) >= kParallelCacheLine ? 1 : kParallelCacheLine / sizeof(T);
+  size_t min_chunk = std::max<size_t>(kParallelMinChunkBytes / sizeof(T), 1);
+  size_t chunk = std::max(count / (pool.ThreadCount() * 4) + 1, min_chunk);
+  return (chunk + per_line - 1) / per_line * per_line;
+}
+
+// Вызывает func(begin, end) для отрезков [0, count) длины chunk, последний отрезок выполняет сам.
+// Первое исключение из задач пробрасывается после завершения всех отрезков
+template <class Function>
+void ParallelForRange(size_t count, size_t chunk, Function func, ThreadPool& pool) {
+  if (count == 0) {
+    return;
+  }
+  size_t chunks = (count + chunk - 1) / chunk;
+  std::atomic<size_t> pending = chunks - 1;
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto run = [&](size_t index) {
+    try {
+      func(index * chunk, std::min(count, (index + 1) * chunk));
+    } catch (...) {
+      std::lock_guard lock(error_mutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+  for (size_t i = 0; i + 1 < chunks; ++i) {
+    pool.Submit([&run, &pending, i] {
+      run(i);
+      pending.fetch_sub(1, std::memory_order_release);
+    });
+  }
+  run(chunks - 1);
+  pool.WaitFor(pending);
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+template <class RandomIt, class T>
+void ParallelFill(RandomIt first, RandomIt last, const T& value, ThreadPool& pool = ThreadPool::Default()) {
+  using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+  size_t count = last - first;
+  ParallelForRange(count, ParallelChunkSize<ValueType>(count, pool), [&](size_t begin, size_t end) {
+    std::fill(first + begin, first + end, value);
+  }, pool);
+}
+
+template <class RandomIt, class OutputIt>
+OutputIt ParallelCopy(RandomIt first, RandomIt last, OutputIt out, ThreadPool& pool = ThreadPool::Default()) {
+  using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+  size_t count = last - first;
+  ParallelForRange(count, ParallelChunkSize<ValueType>(count, pool), [&](size_t begin, size_t end) {
+    std::copy(first + begin, first + end, out + begin);
+  }, pool);
+  return out + count;
+}
+
+template <class RandomIt, class OutputIt, class UnaryOp>
+OutputIt ParallelTransform(RandomIt first, RandomIt last, OutputIt out, UnaryOp op,
+                           ThreadPool& pool = ThreadPool::Default()) {
+  using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+  size_t count = last - first;
+  ParallelForRange(count, ParallelChunkSize<ValueType>(count, pool), [&](size_t begin, size_t end) {
+    std::transform(first + begin, first + end, out + begin, op);
+  }, pool);
+  return out + count;
+}
+
+// op должна быть ассоциативной: чанки сворачиваются независимо, затем результаты - по порядку
+template <class RandomIt, class T, class BinaryOp = std::plus<>>
+T ParallelReduce(RandomIt first, RandomIt last, T init, BinaryOp op = BinaryOp(),
+                 ThreadPool& pool = ThreadPool::Default()) {
+  using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+  size_t count = last - first;
+  size_t chunk = ParallelChunkSize<ValueType>(count, pool);
+  std::vector<std::optional<T>> partials((count + chunk - 1) / chunk);
+  ParallelForRange(count, chunk, [&](size_t begin, size_t end) {
+    T acc = first[begin];
+    for (size_t i = begin + 1; i < end; ++i) {
+      acc = op(std::move(acc), first[i]);
+    }
+    partials[begin / chunk].emplace(std::move(acc));
+  }, pool);
+  for (auto& partial : partials) {
+    init = op(std::move(init), std::move(*partial));
+  }
+  return init;
+}
+
+// Чанки сортируются параллельно, затем сливаются попарно раундами, в каждом раунде пары сливаются параллельно
+template <class RandomIt, class Compare = std::less<>>
+void ParallelSort(RandomIt first, RandomIt last, Compare comp = Compare(), ThreadPool& pool = ThreadPool::Default()) {
+  using ValueType = typename std::iterator_traits<RandomIt>::value_type;
+  size_t count = last - first;
+  size_t chunk = ParallelChunkSize<ValueType>(count, pool);
+  if (count <= chunk) {
+    std::sort(first, last, comp);
+    return;
+  }
+  ParallelForRange(count, chunk, [&](size_t begin, size_t end) {
+    std::sort(first + begin, first + end, comp);
+  }, pool);
+  for (size_t width = chunk; width < count; width *= 2) {
+    size_t pairs = (count + 2 * width - 1) / (2 * width);
+    ParallelForRange(pairs, 1, [&](size_t begin, size_t end) {
+      for (size_t pair = begin; pair < end; ++pair) {
+        size_t low = pair * 2 * width;
+        size_t middle = std::min(count, low + width);
+        size_t high = std::min(count, low + 2 * width);
+        if (middle < high) {
+          std::inplace_merge(first + low, first + middle, first + high, comp);
+        }
+      }
+    }, pool);
+  }
+}
+
+// Перегрузки для Vector
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook, class U>
+void ParallelFill(Vector<T, Allocator, GrowthPolicy, StatsHook>& v, const U& value,
+                  ThreadPool& pool = ThreadPool::Default()) {
+  ParallelFill(v.Data(), v.Data() + v.Size(), value, pool);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook, class UnaryOp>
+void ParallelTransform(Vector<T, Allocator, GrowthPolicy, StatsHook>& v, UnaryOp op,
+                       ThreadPool& pool = ThreadPool::Default()) {
+  ParallelTransform(v.Data(), v.Data() + v.Size(), v.Data(), op, pool);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook, class U,
+          class BinaryOp = std::plus<>>
+U ParallelReduce(const Vector<T, Allocator, GrowthPolicy, StatsHook>& v, U init, BinaryOp op = BinaryOp(),
+                 ThreadPool& pool = ThreadPool::Default()) {
+  return ParallelReduce(v.Data(), v.Data() + v.Size(), std::move(init), op, pool);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook, class Compare = std::less<>>
+void ParallelSort(Vector<T, Allocator, GrowthPolicy, StatsHook>& v, Compare comp = Compare(),
+                  ThreadPool& pool = ThreadPool::Default()) {
+  ParallelSort(v.Data(), v.Data() + v.Size(), comp, pool);
+}
+
+#endif  // PARALLEL_ALGORITHMS_H
@@ -0,0 +1,121 @@
+#ifndef POOL_ALLOCATOR_H
+#define POOL_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+// Пул свободных блоков своего потока, разбитый на классы размеров 16, 32, ..., 4096 байт.
+// Освобожденный блок не возвращается системе, а попадает в список потока, который его освободил
+class ThreadLocalPool {
+ public:
+  static constexpr size_t kMinBlock = 16;
+  static constexpr size_t kMaxBlock = 4096;
+  static constexpr size_t kClassCount = 9;
+
+  static void* Allocate(size_t bytes);
+  static void Deallocate(void* ptr, size_t bytes) noexcept;
+
+ private:
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+
+  struct Lists {
+    FreeBlock* heads[kClassCount] = {};
+    ~Lists();
+  };
+
+  static size_t ClassIndex(size_t bytes);
+  static Lists& Local();
+};
+
+template <typename T>
+class PoolAllocator {
+ public:
+  using value_type = T; // NOLINT
+  using is_always_equal = std::true_type; // NOLINT
+
+  PoolAllocator() = default;
+  template <typename U>
+  PoolAllocator(const PoolAllocator<U>&) {}  // NOLINT
+
+  T* allocate(size_t count) {  // NOLINT
+    if constexpr (alignof(T) > ThreadLocalPool::kMinBlock) {
+      return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+    } else {
+      return static_cast<T*>(ThreadLocalPool::Allocate(count * sizeof(T)));
+    }
+  }
+  void deallocate(T* ptr, size_t count) noexcept {  // NOLINT
+    if constexpr (alignof(T) > ThreadLocalPool::kMinBlock) {
+      ::operator delete(ptr, std::align_val_t(alignof(T)));
+    } else {
+      ThreadLocalPool::Deallocate(ptr, count * sizeof(T));
+    }
+  }
+
+  template <typename U>
+  friend bool operator==(const PoolAllocator&, const PoolAllocator<U>&) {
+    return true;
+  }
+  template <typename U>
+  friend bool operator!=(const PoolAllocator&, const PoolAllocator<U>&) {
+    return false;
+  }
+};
+
+// Методы
+inline size_t ThreadLocalPool::ClassIndex(size_t bytes) {
+  size_t index = 0;
+  for (size_t size = kMinBlock; size < bytes; size *= 2) {
+    ++index;
+  }
+  return index;
+}
+
+inline ThreadLocalPool::Lists& ThreadLocalPool::Local() {
+  thread_local Lists lists;
+  return lists;
+}
+
+inline void* ThreadLocalPool::Allocate(size_t bytes) {
+  if (bytes > kMaxBlock) {
+    return ::operator new(bytes);
+  }
+  size_t index = ClassIndex(bytes);
+  FreeBlock*& head = Local().heads[index];
+  if (head == nullptr) {
+    return ::operator new(kMinBlock << index);
+  }
+  FreeBlock* block = head;
+  head = block->next;
+  return block;
+}
+
+inline void ThreadLocalPool::Deallocate(void* ptr, size_t bytes) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  if (bytes > kMaxBlock) {
+    ::operator delete(ptr);
+    return;
+  }
+  FreeBlock*& head = Local().heads[ClassIndex(bytes)];
+  auto block = static_cast<FreeBlock*>(ptr);
+  block->next = head;
+  head = block;
+}
+
+// Деструктор
+inline ThreadLocalPool::Lists::~Lists() {
+  for (auto& head : heads) {
+    while (head != nullptr) {
+      FreeBlock* next = head->next;
+      ::operator delete(head);
+      head = next;
+    }
+  }
+}
+
+#endif  // POOL_ALLOCATOR_H
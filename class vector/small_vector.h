@@ -0,0 +1,515 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "const_iterator.h"
+#include "iterator.h"
+
+// Вектор, который хранит до N элементов внутри объекта и уходит в кучу только при переполнении
+template <typename T, size_t N>
+class SmallVector {
+  static_assert(N > 0, "SmallVector needs at least one inline element");
+
+public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = ::Iterator<T>;
+  using ConstIterator = ::ConstIterator<T>;
+  using ReverseIterator = std::reverse_iterator<Iterator>;
+  using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+  SmallVector();
+  SmallVector(const SmallVector&);
+  SmallVector(SmallVector&&) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+  explicit SmallVector(SizeType size);
+  explicit SmallVector(SizeType size, T value);
+
+  template <class InputIterator, class =
+  std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename
+  std::iterator_traits<InputIterator>::iterator_category>>>
+  SmallVector(InputIterator first, InputIterator last) : SmallVector() {
+    Reserve(std::distance(first, last));
+    std::uninitialized_copy(first, last, arr_);
+    size_ = std::distance(first, last);
+  }
+
+  SmallVector(std::initializer_list<T> list);
+
+  [[nodiscard]] SizeType Size() const;
+  [[nodiscard]] SizeType Capacity() const;
+  [[nodiscard]] bool Empty() const;
+  [[nodiscard]] bool IsInline() const;
+
+  SmallVector& operator=(const SmallVector&);
+  SmallVector& operator=(SmallVector&&) noexcept(std::is_nothrow_move_constructible_v<T>);
+
+  ConstReference operator[](SizeType ind) const;
+  Reference operator[](SizeType ind);
+
+  ConstReference At(SizeType ind) const;
+  Reference At(SizeType ind);
+
+  ConstReference Front() const;
+  Reference Front();
+
+  ConstReference Back() const;
+  Reference Back();
+
+  Pointer Data();
+  ConstPointer Data() const;
+
+  void Swap(SmallVector&);
+  void Resize(SizeType new_size);
+  void Resize(SizeType new_size, ValueType value);
+  void Reserve(SizeType new_cap);
+  void ShrinkToFit();
+  void Clear();
+
+  void PushBack(ConstReference);
+  void PushBack(ValueType&&);
+  void PopBack();
+
+  template <class... Args>
+  Reference EmplaceBack(Args&&... args);
+  template <class... Args>
+  Iterator Emplace(ConstIterator pos, Args&&... args);
+
+  ~SmallVector();
+
+  bool operator<(const SmallVector& other) const;
+  bool operator>(const SmallVector& other) const;
+  bool operator>=(const SmallVector& other) const;
+  bool operator<=(const SmallVector& other) const;
+  bool operator==(const SmallVector& other) const;
+  bool operator!=(const SmallVector& other) const;
+
+  Iterator begin();  // NOLINT
+  Iterator end(); // NOLINT
+
+  ConstIterator begin() const; // NOLINT
+  ConstIterator end() const; // NOLINT
+
+  ConstIterator cbegin() const; // NOLINT
+  ConstIterator cend() const; // NOLINT
+
+  ReverseIterator rbegin(); // NOLINT
+  ReverseIterator rend(); // NOLINT
+
+  ConstReverseIterator rbegin() const; // NOLINT
+  ConstReverseIterator rend() const; // NOLINT
+
+  ConstReverseIterator crbegin() const; // NOLINT
+  ConstReverseIterator crend() const; // NOLINT
+
+private:
+  Pointer InlineData();
+  // Переносит элементы в new_arr (в кучу или во внутренний буфер) и освобождает старую кучу
+  void MoveStorage(Pointer new_arr, SizeType new_cap);
+  SizeType NextCapacity() const;
+
+  static Pointer Allocate(SizeType count);
+  static void Deallocate(Pointer ptr) noexcept;
+
+  Pointer arr_;
+  SizeType size_;
+  SizeType capacity_;
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+
+// Работа с памятью
+template <typename T, size_t N> typename SmallVector<T, N>::Pointer SmallVector<T, N>::InlineData() {
+  return reinterpret_cast<Pointer>(buffer_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Pointer SmallVector<T, N>::Allocate(SizeType count) {
+  if (count > std::numeric_limits<SizeType>::max() / sizeof(T)) {
+    throw std::length_error("SmallVector is too long");
+  }
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    return static_cast<Pointer>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+  } else {
+    return static_cast<Pointer>(::operator new(count * sizeof(T)));
+  }
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::Deallocate(Pointer ptr) noexcept {
+  if constexpr (alignof(T) > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+    ::operator delete(ptr, std::align_val_t(alignof(T)));
+  } else {
+    ::operator delete(ptr);
+  }
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::MoveStorage(Pointer new_arr, SizeType new_cap) {
+  if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+    std::uninitialized_move_n(arr_, size_, new_arr);
+  } else {
+    std::uninitialized_copy_n(arr_, size_, new_arr);
+  }
+  std::destroy_n(arr_, size_);
+  if (!IsInline()) {
+    Deallocate(arr_);
+  }
+  arr_ = new_arr;
+  capacity_ = new_cap;
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::SizeType SmallVector<T, N>::NextCapacity() const {
+  return capacity_ * 2;
+}
+
+// Конструкторы
+template <typename T, size_t N> SmallVector<T, N>::SmallVector()
+    : arr_(reinterpret_cast<Pointer>(buffer_)), size_(0), capacity_(N) {
+}
+
+template <typename T, size_t N> SmallVector<T, N>::SmallVector(const SmallVector& other) : SmallVector() {
+  Reserve(other.size_);
+  std::uninitialized_copy_n(other.arr_, other.size_, arr_);
+  size_ = other.size_;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>::SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    : SmallVector() {
+  if (!other.IsInline()) {
+    arr_ = other.arr_;
+    capacity_ = other.capacity_;
+    size_ = other.size_;
+    other.arr_ = other.InlineData();
+    other.capacity_ = N;
+  } else {
+    std::uninitialized_move_n(other.arr_, other.size_, arr_);
+    size_ = other.size_;
+    std::destroy_n(other.arr_, other.size_);
+  }
+  other.size_ = 0;
+}
+
+template <typename T, size_t N> SmallVector<T, N>::SmallVector(SizeType size) : SmallVector() {
+  Reserve(size);
+  std::uninitialized_value_construct_n(arr_, size);
+  size_ = size;
+}
+
+template <typename T, size_t N> SmallVector<T, N>::SmallVector(SizeType size, T value) : SmallVector() {
+  Reserve(size);
+  std::uninitialized_fill_n(arr_, size, value);
+  size_ = size;
+}
+
+template <typename T, size_t N> SmallVector<T, N>::SmallVector(std::initializer_list<T> list) : SmallVector() {
+  Reserve(list.size());
+  std::uninitialized_copy(list.begin(), list.end(), arr_);
+  size_ = list.size();
+}
+
+// Присваивание
+template <typename T, size_t N> SmallVector<T, N>& SmallVector<T, N>::operator=(const SmallVector& other) {
+  if (this != &other) {
+    SmallVector copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t N>
+SmallVector<T, N>& SmallVector<T, N>::operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+  if (this != &other) {
+    Clear();
+    if (!other.IsInline()) {
+      arr_ = other.arr_;
+      capacity_ = other.capacity_;
+      size_ = other.size_;
+      other.arr_ = other.InlineData();
+      other.capacity_ = N;
+    } else {
+      std::uninitialized_move_n(other.arr_, other.size_, arr_);
+      size_ = other.size_;
+      std::destroy_n(other.arr_, other.size_);
+    }
+    other.size_ = 0;
+  }
+  return *this;
+}
+
+// Методы
+template <typename T, size_t N> typename SmallVector<T, N>::SizeType SmallVector<T, N>::Size() const {
+  return size_;
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::SizeType SmallVector<T, N>::Capacity() const {
+  return capacity_;
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::Empty() const {
+  return size_ == 0;
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::IsInline() const {
+  return arr_ == reinterpret_cast<ConstPointer>(buffer_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Reference SmallVector<T, N>::operator[](SizeType ind) {
+  return arr_[ind];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReference SmallVector<T, N>::operator[](SizeType ind) const {
+  return arr_[ind];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Reference SmallVector<T, N>::At(SizeType ind) {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return arr_[ind];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReference SmallVector<T, N>::At(SizeType ind) const {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return arr_[ind];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Reference SmallVector<T, N>::Front() {
+  return arr_[0];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReference SmallVector<T, N>::Front() const {
+  return arr_[0];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Reference SmallVector<T, N>::Back() {
+  return arr_[size_ - 1];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReference SmallVector<T, N>::Back() const {
+  return arr_[size_ - 1];
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Pointer SmallVector<T, N>::Data() {
+  return arr_;
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstPointer SmallVector<T, N>::Data() const {
+  return arr_;
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::Swap(SmallVector& other) {
+  if (!IsInline() && !other.IsInline()) {
+    std::swap(arr_, other.arr_);
+    std::swap(size_, other.size_);
+    std::swap(capacity_, other.capacity_);
+    return;
+  }
+  SmallVector tmp(std::move(other));
+  other = std::move(*this);
+  *this = std::move(tmp);
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::Resize(SizeType new_size) {
+  Reserve(new_size);
+  if (new_size > size_) {
+    std::uninitialized_value_construct(arr_ + size_, arr_ + new_size);
+  } else {
+    std::destroy(arr_ + new_size, arr_ + size_);
+  }
+  size_ = new_size;
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::Resize(SizeType new_size, ValueType value) {
+  Reserve(new_size);
+  if (new_size > size_) {
+    std::uninitialized_fill(arr_ + size_, arr_ + new_size, value);
+  } else {
+    std::destroy(arr_ + new_size, arr_ + size_);
+  }
+  size_ = new_size;
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::Reserve(SizeType new_cap) {
+  if (new_cap > capacity_) {
+    Pointer new_arr = Allocate(new_cap);
+    try {
+      MoveStorage(new_arr, new_cap);
+    } catch (...) {
+      Deallocate(new_arr);
+      throw;
+    }
+  }
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::ShrinkToFit() {
+  if (IsInline() || size_ == capacity_) {
+    return;
+  }
+  if (size_ <= N) {
+    MoveStorage(InlineData(), N);
+    return;
+  }
+  Pointer new_arr = Allocate(size_);
+  try {
+    MoveStorage(new_arr, size_);
+  } catch (...) {
+    Deallocate(new_arr);
+    throw;
+  }
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::Clear() {
+  std::destroy_n(arr_, size_);
+  size_ = 0;
+  if (!IsInline()) {
+    Deallocate(arr_);
+    arr_ = InlineData();
+    capacity_ = N;
+  }
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::PushBack(ConstReference value) {
+  EmplaceBack(value);
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::PushBack(ValueType&& value) {
+  EmplaceBack(std::move(value));
+}
+
+template <typename T, size_t N> void SmallVector<T, N>::PopBack() {
+  if (size_ > 0) {
+    --size_;
+    std::destroy_at(arr_ + size_);
+  }
+}
+
+template <typename T, size_t N>
+template <class... Args>
+typename SmallVector<T, N>::Reference SmallVector<T, N>::EmplaceBack(Args&&... args) {
+  if (size_ == capacity_) {
+    // args могут ссылаться на элемент этого же вектора, поэтому значение строится до переноса
+    T value(std::forward<Args>(args)...);
+    Reserve(NextCapacity());
+    ::new (static_cast<void*>(arr_ + size_)) T(std::move(value));
+  } else {
+    ::new (static_cast<void*>(arr_ + size_)) T(std::forward<Args>(args)...);
+  }
+  return arr_[size_++];
+}
+
+template <typename T, size_t N>
+template <class... Args>
+typename SmallVector<T, N>::Iterator SmallVector<T, N>::Emplace(ConstIterator pos, Args&&... args) {
+  SizeType index = pos - cbegin();
+  if (index == size_) {
+    EmplaceBack(std::forward<Args>(args)...);
+    return begin() + index;
+  }
+  T value(std::forward<Args>(args)...);
+  if (size_ == capacity_) {
+    Reserve(NextCapacity());
+  }
+  ::new (static_cast<void*>(arr_ + size_)) T(std::move(arr_[size_ - 1]));
+  ++size_;
+  std::move_backward(arr_ + index, arr_ + size_ - 2, arr_ + size_ - 1);
+  arr_[index] = std::move(value);
+  return begin() + index;
+}
+
+// Итераторы
+template <typename T, size_t N> typename SmallVector<T, N>::Iterator SmallVector<T, N>::begin() {  // NOLINT
+  return Iterator(arr_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::Iterator SmallVector<T, N>::end() {  // NOLINT
+  return Iterator(arr_ + size_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstIterator SmallVector<T, N>::begin() const {  // NOLINT
+  return ConstIterator(arr_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstIterator SmallVector<T, N>::end() const {  // NOLINT
+  return ConstIterator(arr_ + size_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstIterator SmallVector<T, N>::cbegin() const {  // NOLINT
+  return ConstIterator(arr_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstIterator SmallVector<T, N>::cend() const {  // NOLINT
+  return ConstIterator(arr_ + size_);
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ReverseIterator SmallVector<T, N>::rbegin() {  // NOLINT
+  return std::make_reverse_iterator(end());
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ReverseIterator SmallVector<T, N>::rend() {  // NOLINT
+  return std::make_reverse_iterator(begin());
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReverseIterator SmallVector<T, N>::rbegin() const {  // NOLINT
+  return std::make_reverse_iterator(end());
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReverseIterator SmallVector<T, N>::rend() const {  // NOLINT
+  return std::make_reverse_iterator(begin());
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReverseIterator SmallVector<T, N>::crbegin() const {  // NOLINT
+  return std::make_reverse_iterator(cend());
+}
+
+template <typename T, size_t N> typename SmallVector<T, N>::ConstReverseIterator SmallVector<T, N>::crend() const {  // NOLINT
+  return std::make_reverse_iterator(cbegin());
+}
+
+// Сравнения
+template <typename T, size_t N> bool SmallVector<T, N>::operator<(const SmallVector& other) const {
+  return std::lexicographical_compare(arr_, arr_ + size_, other.arr_, other.arr_ + other.size_);
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::operator>(const SmallVector& other) const {
+  return other < *this;
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::operator>=(const SmallVector& other) const {
+  return !(*this < other);
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::operator<=(const SmallVector& other) const {
+  return !(*this > other);
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::operator==(const SmallVector& other) const {
+  return size_ == other.size_ && std::equal(arr_, arr_ + size_, other.arr_);
+}
+
+template <typename T, size_t N> bool SmallVector<T, N>::operator!=(const SmallVector& other) const {
+  return !(*this == other);
+}
+
+// Деструктор
+template <typename T, size_t N> SmallVector<T, N>::~SmallVector() {
+  std::destroy_n(arr_, size_);
+  if (!IsInline()) {
+    Deallocate(arr_);
+  }
+}
+
+#endif  // SMALL_VECTOR_H
@@ -0,0 +1,331 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "growth_policy.h"
+#include "vector.h"
+
+template <typename... Ts>
+class SoaVector;
+
+// Итератор произвольного доступа по строкам SoaVector: разыменование дает кортеж ссылок на поля строки
+template <bool kIsConst, typename... Ts>
+class SoaVectorIterator {
+  using Owner = std::conditional_t<kIsConst, const SoaVector<Ts...>, SoaVector<Ts...>>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag; // NOLINT
+  using difference_type = std::ptrdiff_t; // NOLINT
+  using value_type = std::tuple<Ts...>; // NOLINT
+  using reference = std::conditional_t<kIsConst, std::tuple<const Ts&...>, std::tuple<Ts&...>>; // NOLINT
+  using pointer = void; // NOLINT
+
+  SoaVectorIterator() = default;
+  SoaVectorIterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+  template <bool kOtherConst, class = std::enable_if_t<kIsConst && !kOtherConst>>
+  SoaVectorIterator(const SoaVectorIterator<kOtherConst, Ts...>& other)  // NOLINT
+      : owner_(other.owner_), index_(other.index_) {}
+
+  reference operator*() const {
+    return (*owner_)[index_];
+  }
+  reference operator[](difference_type value) const {
+    return (*owner_)[index_ + value];
+  }
+  SoaVectorIterator& operator++() {
+    ++index_;
+    return *this;
+  }
+  const SoaVectorIterator operator++(int) {
+    const SoaVectorIterator helper = *this;
+    ++(*this);
+    return helper;
+  }
+  SoaVectorIterator& operator--() {
+    --index_;
+    return *this;
+  }
+  const SoaVectorIterator operator--(int) {
+    const SoaVectorIterator helper = *this;
+    --(*this);
+    return helper;
+  }
+  friend bool operator==(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return first.index_ == second.index_;
+  }
+  friend bool operator!=(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return first.index_ != second.index_;
+  }
+  friend bool operator>(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return first.index_ > second.index_;
+  }
+  friend bool operator<(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return first.index_ < second.index_;
+  }
+  friend bool operator>=(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return first.index_ >= second.index_;
+  }
+  friend bool operator<=(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return first.index_ <= second.index_;
+  }
+  friend difference_type operator-(const SoaVectorIterator& first, const SoaVectorIterator& second) {
+    return static_cast<difference_type>(first.index_) - static_cast<difference_type>(second.index_);
+  }
+  friend SoaVectorIterator operator+(const SoaVectorIterator& iterator, difference_type value) {
+    SoaVectorIterator result = iterator;
+    result.index_ += value;
+    return result;
+  }
+  friend SoaVectorIterator operator+(difference_type value, const SoaVectorIterator& iterator) {
+    return iterator + value;
+  }
+  friend SoaVectorIterator operator-(const SoaVectorIterator& iterator, difference_type value) {
+    SoaVectorIterator result = iterator;
+    result.index_ -= value;
+    return result;
+  }
+  SoaVectorIterator& operator+=(difference_type value) {
+    index_ += value;
+    return *this;
+  }
+  SoaVectorIterator& operator-=(difference_type value) {
+    index_ -= value;
+    return *this;
+  }
+
+ private:
+  template <bool kConst, typename... Us>
+  friend class SoaVectorIterator;
+
+  Owner* owner_ = nullptr;
+  size_t index_ = 0;
+};
+
+// Вектор записей, разложенный по столбцам: поле I всех записей лежит подряд в своем Vector,
+// поэтому проход по одному полю читает только его. Все столбцы растут вместе, как Vector
+template <typename... Ts>
+class SoaVector {
+  static_assert(sizeof...(Ts) > 0, "SoaVector needs at least one column");
+
+public:
+  using ValueType = std::tuple<Ts...>;
+  using Reference = std::tuple<Ts&...>;
+  using ConstReference = std::tuple<const Ts&...>;
+  using SizeType = size_t;
+  using Iterator = SoaVectorIterator<false, Ts...>;
+  using ConstIterator = SoaVectorIterator<true, Ts...>;
+
+  template <size_t I>
+  using ColumnType = std::tuple_element_t<I, ValueType>;
+
+  SoaVector() = default;
+
+  [[nodiscard]] SizeType Size() const;
+  [[nodiscard]] SizeType Capacity() const;
+  [[nodiscard]] bool Empty() const;
+
+  ConstReference operator[](SizeType ind) const;
+  Reference operator[](SizeType ind);
+
+  ConstReference At(SizeType ind) const;
+  Reference At(SizeType ind);
+
+  // Столбец целиком: указатель на Size() подряд лежащих значений поля I
+  template <size_t I>
+  ColumnType<I>* Data();
+  template <size_t I>
+  const ColumnType<I>* Data() const;
+  template <size_t I>
+  const Vector<ColumnType<I>>& Column() const;
+
+  void Reserve(SizeType new_cap);
+  void ShrinkToFit();
+  void Clear();
+
+  void PushBack(const ValueType&);
+  void PushBack(ValueType&&);
+  void PopBack();
+
+  template <class... Args>
+  void EmplaceBack(Args&&... args);
+
+  Iterator begin();  // NOLINT
+  Iterator end(); // NOLINT
+
+  ConstIterator begin() const; // NOLINT
+  ConstIterator end() const; // NOLINT
+
+  ConstIterator cbegin() const; // NOLINT
+  ConstIterator cend() const; // NOLINT
+
+private:
+  template <size_t... I>
+  Reference Row(SizeType ind, std::index_sequence<I...>);
+  template <size_t... I>
+  ConstReference Row(SizeType ind, std::index_sequence<I...>) const;
+
+  // Добавляет поле I и следующие, при исключении снимает уже добавленные поля этой строки
+  template <size_t I, class Tuple>
+  void EmplaceColumns(Tuple&& values);
+  void GrowIfFull();
+
+  std::tuple<Vector<Ts>...> columns_;
+  SizeType capacity_ = 0;
+};
+
+// Методы
+template <typename... Ts> typename SoaVector<Ts...>::SizeType SoaVector<Ts...>::Size() const {
+  return std::get<0>(columns_).Size();
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::SizeType SoaVector<Ts...>::Capacity() const {
+  return capacity_;
+}
+
+template <typename... Ts> bool SoaVector<Ts...>::Empty() const {
+  return Size() == 0;
+}
+
+template <typename... Ts>
+template <size_t... I>
+typename SoaVector<Ts...>::Reference SoaVector<Ts...>::Row(SizeType ind, std::index_sequence<I...>) {
+  return Reference(std::get<I>(columns_)[ind]...);
+}
+
+template <typename... Ts>
+template <size_t... I>
+typename SoaVector<Ts...>::ConstReference SoaVector<Ts...>::Row(SizeType ind, std::index_sequence<I...>) const {
+  return ConstReference(std::get<I>(columns_)[ind]...);
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::ConstReference SoaVector<Ts...>::operator[](SizeType ind) const {
+  return Row(ind, std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::Reference SoaVector<Ts...>::operator[](SizeType ind) {
+  return Row(ind, std::index_sequence_for<Ts...>());
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::ConstReference SoaVector<Ts...>::At(SizeType ind) const {
+  if (ind >= Size()) {
+    throw std::out_of_range("Index out of range");
+  }
+  return (*this)[ind];
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::Reference SoaVector<Ts...>::At(SizeType ind) {
+  if (ind >= Size()) {
+    throw std::out_of_range("Index out of range");
+  }
+  return (*this)[ind];
+}
+
+template <typename... Ts>
+template <size_t I>
+typename SoaVector<Ts...>::template ColumnType<I>* SoaVector<Ts...>::Data() {
+  return std::get<I>(columns_).Data();
+}
+
+template <typename... Ts>
+template <size_t I>
+const typename SoaVector<Ts...>::template ColumnType<I>* SoaVector<Ts...>::Data() const {
+  return std::get<I>(columns_).Data();
+}
+
+template <typename... Ts>
+template <size_t I>
+const Vector<typename SoaVector<Ts...>::template ColumnType<I>>& SoaVector<Ts...>::Column() const {
+  return std::get<I>(columns_);
+}
+
+template <typename... Ts> void SoaVector<Ts...>::Reserve(SizeType new_cap) {
+  if (new_cap > capacity_) {
+    std::apply([new_cap](auto&... column) { (column.Reserve(new_cap), ...); }, columns_);
+    capacity_ = new_cap;
+  }
+}
+
+template <typename... Ts> void SoaVector<Ts...>::ShrinkToFit() {
+  std::apply([](auto&... column) { (column.ShrinkToFit(), ...); }, columns_);
+  capacity_ = Size();
+}
+
+template <typename... Ts> void SoaVector<Ts...>::Clear() {
+  std::apply([](auto&... column) { (column.Clear(), ...); }, columns_);
+  capacity_ = 0;
+}
+
+template <typename... Ts> void SoaVector<Ts...>::GrowIfFull() {
+  if (Size() == capacity_) {
+    Reserve(DoublingGrowth::Grow(capacity_, (sizeof(Ts) + ...)));
+  }
+}
+
+template <typename... Ts>
+template <size_t I, class Tuple>
+void SoaVector<Ts...>::EmplaceColumns(Tuple&& values) {
+  if constexpr (I < sizeof...(Ts)) {
+    std::get<I>(columns_).EmplaceBack(std::get<I>(std::forward<Tuple>(values)));
+    try {
+      EmplaceColumns<I + 1>(std::forward<Tuple>(values));
+    } catch (...) {
+      std::get<I>(columns_).PopBack();
+      throw;
+    }
+  }
+}
+
+template <typename... Ts> void SoaVector<Ts...>::PushBack(const ValueType& value) {
+  GrowIfFull();
+  EmplaceColumns<0>(value);
+}
+
+template <typename... Ts> void SoaVector<Ts...>::PushBack(ValueType&& value) {
+  GrowIfFull();
+  EmplaceColumns<0>(std::move(value));
+}
+
+template <typename... Ts>
+template <class... Args>
+void SoaVector<Ts...>::EmplaceBack(Args&&... args) {
+  static_assert(sizeof...(Args) == sizeof...(Ts), "EmplaceBack takes one value per column");
+  GrowIfFull();
+  EmplaceColumns<0>(std::forward_as_tuple(std::forward<Args>(args)...));
+}
+
+template <typename... Ts> void SoaVector<Ts...>::PopBack() {
+  std::apply([](auto&... column) { (column.PopBack(), ...); }, columns_);
+}
+
+// Итераторы
+template <typename... Ts> typename SoaVector<Ts...>::Iterator SoaVector<Ts...>::begin() {  // NOLINT
+  return Iterator(this, 0);
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::Iterator SoaVector<Ts...>::end() {  // NOLINT
+  return Iterator(this, Size());
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::ConstIterator SoaVector<Ts...>::begin() const {  // NOLINT
+  return ConstIterator(this, 0);
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::ConstIterator SoaVector<Ts...>::end() const {  // NOLINT
+  return ConstIterator(this, Size());
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::ConstIterator SoaVector<Ts...>::cbegin() const {  // NOLINT
+  return ConstIterator(this, 0);
+}
+
+template <typename... Ts> typename SoaVector<Ts...>::ConstIterator SoaVector<Ts...>::cend() const {  // NOLINT
+  return ConstIterator(this, Size());
+}
+
+#endif  // SOA_VECTOR_H
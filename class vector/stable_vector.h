@@ -0,0 +1,409 @@
+#ifndef STABLE_VECTOR_H
+#define STABLE_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.h"
+
+template <typename T, size_t kChunkSize>
+class StableVector;
+
+// Итератор произвольного доступа по StableVector: хранит вектор и индекс, поэтому остается валидным при росте
+template <typename T, size_t kChunkSize, bool kIsConst>
+class StableVectorIterator {
+  using Owner = std::conditional_t<kIsConst, const StableVector<T, kChunkSize>, StableVector<T, kChunkSize>>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag; // NOLINT
+  using difference_type = std::ptrdiff_t; // NOLINT
+  using value_type = T; // NOLINT
+  using pointer = std::conditional_t<kIsConst, const T*, T*>; // NOLINT
+  using reference = std::conditional_t<kIsConst, const T&, T&>; // NOLINT
+
+  StableVectorIterator() = default;
+  StableVectorIterator(Owner* owner, size_t index) : owner_(owner), index_(index) {}
+  template <bool kOtherConst, class = std::enable_if_t<kIsConst && !kOtherConst>>
+  StableVectorIterator(const StableVectorIterator<T, kChunkSize, kOtherConst>& other)  // NOLINT
+      : owner_(other.owner_), index_(other.index_) {}
+
+  reference operator*() const {
+    return (*owner_)[index_];
+  }
+  pointer operator->() const {
+    return &(*owner_)[index_];
+  }
+  reference operator[](difference_type value) const {
+    return (*owner_)[index_ + value];
+  }
+  StableVectorIterator& operator++() {
+    ++index_;
+    return *this;
+  }
+  const StableVectorIterator operator++(int) {
+    const StableVectorIterator helper = *this;
+    ++(*this);
+    return helper;
+  }
+  StableVectorIterator& operator--() {
+    --index_;
+    return *this;
+  }
+  const StableVectorIterator operator--(int) {
+    const StableVectorIterator helper = *this;
+    --(*this);
+    return helper;
+  }
+  friend bool operator==(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return first.index_ == second.index_;
+  }
+  friend bool operator!=(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return first.index_ != second.index_;
+  }
+  friend bool operator>(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return first.index_ > second.index_;
+  }
+  friend bool operator<(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return first.index_ < second.index_;
+  }
+  friend bool operator>=(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return first.index_ >= second.index_;
+  }
+  friend bool operator<=(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return first.index_ <= second.index_;
+  }
+  friend difference_type operator-(const StableVectorIterator& first, const StableVectorIterator& second) {
+    return static_cast<difference_type>(first.index_) - static_cast<difference_type>(second.index_);
+  }
+  friend StableVectorIterator operator+(const StableVectorIterator& iterator, difference_type value) {
+    StableVectorIterator result = iterator;
+    result.index_ += value;
+    return result;
+  }
+  friend StableVectorIterator operator+(difference_type value, const StableVectorIterator& iterator) {
+    return iterator + value;
+  }
+  friend StableVectorIterator operator-(const StableVectorIterator& iterator, difference_type value) {
+    StableVectorIterator result = iterator;
+    result.index_ -= value;
+    return result;
+  }
+  StableVectorIterator& operator+=(difference_type value) {
+    index_ += value;
+    return *this;
+  }
+  StableVectorIterator& operator-=(difference_type value) {
+    index_ -= value;
+    return *this;
+  }
+
+ private:
+  template <typename U, size_t kSize, bool kConst>
+  friend class StableVectorIterator;
+
+  Owner* owner_ = nullptr;
+  size_t index_ = 0;
+};
+
+// Сегментированный вектор: элементы лежат в чанках по kChunkSize штук и никогда не переезжают,
+// поэтому ссылки и указатели на них живут до удаления самого элемента. Рост добавляет один чанк,
+// а переезжает только таблица указателей на чанки
+template <typename T, size_t kChunkSize = 1024>
+class StableVector {
+  static_assert(kChunkSize > 0 && (kChunkSize & (kChunkSize - 1)) == 0, "Chunk size must be a power of two");
+
+public:
+  using ValueType = T;
+  using Pointer = T*;
+  using ConstPointer = const T*;
+  using Reference = T&;
+  using ConstReference = const T&;
+  using SizeType = size_t;
+  using Iterator = StableVectorIterator<T, kChunkSize, false>;
+  using ConstIterator = StableVectorIterator<T, kChunkSize, true>;
+
+  StableVector() = default;
+  StableVector(const StableVector&);
+  StableVector(StableVector&&) noexcept;
+  StableVector(std::initializer_list<T> list);
+
+  StableVector& operator=(const StableVector&);
+  StableVector& operator=(StableVector&&) noexcept;
+
+  [[nodiscard]] SizeType Size() const;
+  [[nodiscard]] SizeType Capacity() const;
+  [[nodiscard]] bool Empty() const;
+
+  ConstReference operator[](SizeType ind) const;
+  Reference operator[](SizeType ind);
+
+  ConstReference At(SizeType ind) const;
+  Reference At(SizeType ind);
+
+  ConstReference Front() const;
+  Reference Front();
+
+  ConstReference Back() const;
+  Reference Back();
+
+  void Swap(StableVector&);
+  void Reserve(SizeType new_cap);
+  void ShrinkToFit();
+  void Clear();
+
+  void PushBack(ConstReference);
+  void PushBack(ValueType&&);
+  void PopBack();
+
+  template <class... Args>
+  Reference EmplaceBack(Args&&... args);
+
+  ~StableVector();
+
+  bool operator<(const StableVector& other) const;
+  bool operator==(const StableVector& other) const;
+  bool operator!=(const StableVector& other) const;
+
+  Iterator begin();  // NOLINT
+  Iterator end(); // NOLINT
+
+  ConstIterator begin() const; // NOLINT
+  ConstIterator end() const; // NOLINT
+
+  ConstIterator cbegin() const; // NOLINT
+  ConstIterator cend() const; // NOLINT
+
+private:
+  static constexpr SizeType kChunkShift = [] {
+    SizeType shift = 0;
+    while ((SizeType(1) << shift) != kChunkSize) {
+      ++shift;
+    }
+    return shift;
+  }();
+
+  void AddChunk();
+
+  Vector<Pointer> chunks_;
+  SizeType size_ = 0;
+};
+
+// Конструкторы
+template <typename T, size_t kChunkSize> StableVector<T, kChunkSize>::StableVector(const StableVector& other) : StableVector() {
+  Reserve(other.size_);
+  for (SizeType i = 0; i < other.size_; ++i) {
+    EmplaceBack(other[i]);
+  }
+}
+
+template <typename T, size_t kChunkSize> StableVector<T, kChunkSize>::StableVector(StableVector&& other) noexcept
+    : chunks_(std::move(other.chunks_)), size_(other.size_) {
+  other.size_ = 0;
+}
+
+template <typename T, size_t kChunkSize> StableVector<T, kChunkSize>::StableVector(std::initializer_list<T> list) : StableVector() {
+  Reserve(list.size());
+  for (const auto& value : list) {
+    EmplaceBack(value);
+  }
+}
+
+// Присваивание
+template <typename T, size_t kChunkSize>
+StableVector<T, kChunkSize>& StableVector<T, kChunkSize>::operator=(const StableVector& other) {
+  if (this != &other) {
+    StableVector copy(other);
+    Swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, size_t kChunkSize>
+StableVector<T, kChunkSize>& StableVector<T, kChunkSize>::operator=(StableVector&& other) noexcept {
+  if (this != &other) {
+    StableVector moved(std::move(other));
+    Swap(moved);
+  }
+  return *this;
+}
+
+// Методы
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::AddChunk() {
+  Pointer chunk = std::allocator<T>().allocate(kChunkSize);
+  try {
+    chunks_.PushBack(chunk);
+  } catch (...) {
+    std::allocator<T>().deallocate(chunk, kChunkSize);
+    throw;
+  }
+}
+
+template <typename T, size_t kChunkSize> typename StableVector<T, kChunkSize>::SizeType StableVector<T, kChunkSize>::Size() const {
+  return size_;
+}
+
+template <typename T, size_t kChunkSize> typename StableVector<T, kChunkSize>::SizeType StableVector<T, kChunkSize>::Capacity() const {
+  return chunks_.Size() * kChunkSize;
+}
+
+template <typename T, size_t kChunkSize> bool StableVector<T, kChunkSize>::Empty() const {
+  return size_ == 0;
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstReference StableVector<T, kChunkSize>::operator[](SizeType ind) const {
+  return chunks_[ind >> kChunkShift][ind & (kChunkSize - 1)];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::Reference StableVector<T, kChunkSize>::operator[](SizeType ind) {
+  return chunks_[ind >> kChunkShift][ind & (kChunkSize - 1)];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstReference StableVector<T, kChunkSize>::At(SizeType ind) const {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return (*this)[ind];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::Reference StableVector<T, kChunkSize>::At(SizeType ind) {
+  if (ind >= size_) {
+    throw std::out_of_range("Index out of range");
+  }
+  return (*this)[ind];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstReference StableVector<T, kChunkSize>::Front() const {
+  return (*this)[0];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::Reference StableVector<T, kChunkSize>::Front() {
+  return (*this)[0];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstReference StableVector<T, kChunkSize>::Back() const {
+  return (*this)[size_ - 1];
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::Reference StableVector<T, kChunkSize>::Back() {
+  return (*this)[size_ - 1];
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::Swap(StableVector& other) {
+  chunks_.Swap(other.chunks_);
+  std::swap(size_, other.size_);
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::Reserve(SizeType new_cap) {
+  SizeType chunks = (new_cap + kChunkSize - 1) >> kChunkShift;
+  chunks_.Reserve(chunks);
+  while (chunks_.Size() < chunks) {
+    AddChunk();
+  }
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::ShrinkToFit() {
+  SizeType used = (size_ + kChunkSize - 1) >> kChunkShift;
+  while (chunks_.Size() > used) {
+    std::allocator<T>().deallocate(chunks_.Back(), kChunkSize);
+    chunks_.PopBack();
+  }
+  chunks_.ShrinkToFit();
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::Clear() {
+  while (size_ > 0) {
+    PopBack();
+  }
+  ShrinkToFit();
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::PushBack(ConstReference value) {
+  EmplaceBack(value);
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::PushBack(ValueType&& value) {
+  EmplaceBack(std::move(value));
+}
+
+template <typename T, size_t kChunkSize> void StableVector<T, kChunkSize>::PopBack() {
+  if (size_ > 0) {
+    --size_;
+    std::destroy_at(&(*this)[size_]);
+  }
+}
+
+template <typename T, size_t kChunkSize>
+template <class... Args>
+typename StableVector<T, kChunkSize>::Reference StableVector<T, kChunkSize>::EmplaceBack(Args&&... args) {
+  // Старые элементы не двигаются, поэтому args может ссылаться на них и после добавления чанка
+  if (size_ == Capacity()) {
+    AddChunk();
+  }
+  Pointer slot = &(*this)[size_];
+  ::new (static_cast<void*>(slot)) T(std::forward<Args>(args)...);
+  ++size_;
+  return *slot;
+}
+
+// Итераторы
+template <typename T, size_t kChunkSize> typename StableVector<T, kChunkSize>::Iterator StableVector<T, kChunkSize>::begin() {  // NOLINT
+  return Iterator(this, 0);
+}
+
+template <typename T, size_t kChunkSize> typename StableVector<T, kChunkSize>::Iterator StableVector<T, kChunkSize>::end() {  // NOLINT
+  return Iterator(this, size_);
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstIterator StableVector<T, kChunkSize>::begin() const {  // NOLINT
+  return ConstIterator(this, 0);
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstIterator StableVector<T, kChunkSize>::end() const {  // NOLINT
+  return ConstIterator(this, size_);
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstIterator StableVector<T, kChunkSize>::cbegin() const {  // NOLINT
+  return ConstIterator(this, 0);
+}
+
+template <typename T, size_t kChunkSize>
+typename StableVector<T, kChunkSize>::ConstIterator StableVector<T, kChunkSize>::cend() const {  // NOLINT
+  return ConstIterator(this, size_);
+}
+
+// Сравнения
+template <typename T, size_t kChunkSize> bool StableVector<T, kChunkSize>::operator<(const StableVector& other) const {
+  return std::lexicographical_compare(begin(), end(), other.begin(), other.end());
+}
+
+template <typename T, size_t kChunkSize> bool StableVector<T, kChunkSize>::operator==(const StableVector& other) const {
+  return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+}
+
+template <typename T, size_t kChunkSize> bool StableVector<T, kChunkSize>::operator!=(const StableVector& other) const {
+  return !(*this == other);
+}
+
+// Деструктор
+template <typename T, size_t kChunkSize> StableVector<T, kChunkSize>::~StableVector() {
+  Clear();
+}
+
+#endif  // STABLE_VECTOR_H
@@ -0,0 +1,156 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с кражей работы: у каждого потока своя очередь, свои задачи он берет с конца,
+// а при пустой очереди забирает самые старые задачи из чужих очередей
+class ThreadPool {
+ public:
+  explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  void Submit(std::function<void()> task);
+  // Ждет, пока pending не обнулится, и сам выполняет задачи пула, чтобы вложенные ожидания не блокировали потоки
+  void WaitFor(const std::atomic<size_t>& pending);
+  size_t ThreadCount() const;
+
+  static ThreadPool& Default();
+
+  ~ThreadPool();
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  void WorkerLoop(size_t index);
+  bool TryRunOne(size_t index);
+
+  static size_t& CurrentIndex();
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<size_t> queued_ = 0;
+  std::atomic<size_t> next_queue_ = 0;
+  bool stop_ = false;
+};
+
+// Конструкторы
+inline ThreadPool::ThreadPool(size_t threads) {
+  if (threads == 0) {
+    threads = 1;
+  }
+  for (size_t i = 0; i < threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+  for (size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+// Методы
+inline size_t& ThreadPool::CurrentIndex() {
+  // Номер очереди потока пула, для посторонних потоков - заведомо неверный номер
+  thread_local size_t index = static_cast<size_t>(-1);
+  return index;
+}
+
+inline void ThreadPool::Submit(std::function<void()> task) {
+  size_t index = CurrentIndex();
+  if (index >= queues_.size()) {
+    index = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+  }
+  {
+    std::lock_guard lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard lock(sleep_mutex_);
+    queued_.fetch_add(1, std::memory_order_release);
+  }
+  wake_.notify_one();
+}
+
+inline bool ThreadPool::TryRunOne(size_t index) {
+  std::function<void()> task;
+  size_t count = queues_.size();
+  if (index < count) {
+    std::lock_guard lock(queues_[index]->mutex);
+    if (!queues_[index]->tasks.empty()) {
+      task = std::move(queues_[index]->tasks.back());
+      queues_[index]->tasks.pop_back();
+    }
+  }
+  for (size_t shift = 1; !task && shift <= count; ++shift) {
+    Queue& victim = *queues_[(index + shift) % count];
+    std::lock_guard lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+    }
+  }
+  if (!task) {
+    return false;
+  }
+  queued_.fetch_sub(1, std::memory_order_relaxed);
+  task();
+  return true;
+}
+
+inline void ThreadPool::WorkerLoop(size_t index) {
+  CurrentIndex() = index;
+  while (true) {
+    if (TryRunOne(index)) {
+      continue;
+    }
+    std::unique_lock lock(sleep_mutex_);
+    wake_.wait(lock, [this] { return stop_ || queued_.load(std::memory_order_acquire) > 0; });
+    if (stop_ && queued_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+inline void ThreadPool::WaitFor(const std::atomic<size_t>& pending) {
+  while (pending.load(std::memory_order_acquire) != 0) {
+    if (!TryRunOne(CurrentIndex())) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+inline size_t ThreadPool::ThreadCount() const {
+  return workers_.size();
+}
+
+inline ThreadPool& ThreadPool::Default() {
+  static ThreadPool pool;
+  return pool;
+}
+
+// Деструктор
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+}
+
+#endif  // THREAD_POOL_H
@@ -2,211 +2,126 @@
 #define VECTOR_H
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "const_iterator.h"
+#include "growth_policy.h"
+#include "iterator.h"
+#include "vector_stats.h"
+
+// Тип можно переносить в другую память побайтовым копированием, не вызывая конструктор перемещения
+// и деструктор старого объекта. Для своих типов с таким свойством можно специализировать.
+template <typename T>
+struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
 
-// Все классы в одном файле, так как при отрпавке архива возникала ошибка, что в файл не в UTF-8 кодировке
-template<typename T>
-class Iterator {
- public:
-  using iterator_category = std::random_access_iterator_tag; // NOLINT
-  using difference_type = std::ptrdiff_t; // NOLINT
-  using value_type = T; // NOLINT
-  using pointer = T*; // NOLINT
-  using reference = T&; // NOLINT
-
-  explicit Iterator(pointer ptr) : ptr_(ptr) {}
-  reference operator*() const {
-    return *ptr_;
-  }
-  pointer operator->() {
-    return ptr_;
-  }
-  Iterator& operator++() {
-    ++ptr_;
-    return *this;
-  }
-  const Iterator operator++(int) {
-    const Iterator helper = *this;
-    ++(*this);
-    return helper;
-  }
-  Iterator& operator--() {
-    --ptr_;
-    return *this;
-  }
-  const Iterator operator--(int) {
-    const Iterator helper = *this;
-    --(*this);
-    return helper;
-  }
-  friend bool operator==(const Iterator& first, const Iterator& second) {
-    return first.ptr_ == second.ptr_;
-  }
-  friend bool operator!=(const Iterator& first, const Iterator& second) {
-    return first.ptr_ != second.ptr_;
-  }
-  friend bool operator>(const Iterator& first, const Iterator& second) {
-    return first.ptr_ > second.ptr_;
-  }
-  friend bool operator<(const Iterator& first, const Iterator& second) {
-    return first.ptr_ < second.ptr_;
-  }
-  friend bool operator>=(const Iterator& first, const Iterator& second) {
-    return first.ptr_ >= second.ptr_;
-  }
-  friend bool operator<=(const Iterator& first, const Iterator& second) {
-    return first.ptr_ <= second.ptr_;
-  }
-  friend difference_type operator-(const Iterator& first, const Iterator& second) {
-    return (first.ptr_ - second.ptr_);
-  }
-  friend Iterator operator+(const Iterator& iterator, const int64_t& value) {
-    Iterator result = iterator;
-    result.ptr_ += value;
-    return result;
+namespace vector_detail {
+// Хранит значение типа T; пустой тип становится базой и не занимает места в объекте.
+// kIndex различает несколько таких баз одного класса
+template <typename T, size_t kIndex, bool = std::is_empty_v<T> && !std::is_final_v<T>>
+class CompressedMember : private T {
+public:
+  CompressedMember() = default;
+  explicit CompressedMember(const T& value) : T(value) {
   }
-  friend Iterator operator-(const Iterator& iterator, const int64_t& value) {
-    Iterator result = iterator;
-    result.ptr_ -= value;
-    return result;
+  explicit CompressedMember(T&& value) : T(std::move(value)) {
   }
-  Iterator& operator+=(const int64_t value) {
-    ptr_ += value;
+
+  T& Get() {
     return *this;
   }
-  Iterator& operator-=(const int64_t value) {
-    ptr_ -= value;
+  const T& Get() const {
     return *this;
   }
-
- private:
-  pointer ptr_;
 };
 
-template<typename T>
-class ConstIterator {
- public:
-  using iterator_category = std::random_access_iterator_tag; // NOLINT
-  using difference_type = std::ptrdiff_t; // NOLINT
-  using value_type = T; // NOLINT
-  using pointer = const T*; // NOLINT
-  using reference = const T&; // NOLINT
-
-  explicit ConstIterator(pointer ptr) : ptr_(ptr) {}
-  const T& operator*() const {
-    return *ptr_;
-  }
-  const T* operator->() {
-    return ptr_;
-  }
-  ConstIterator& operator++() {
-    ++ptr_;
-    return *this;
-  }
-  const ConstIterator operator++(int) {
-    const ConstIterator helper = *this;
-    ++(*this);
-    return helper;
-  }
-  ConstIterator& operator--() {
-    --ptr_;
-    return *this;
-  }
-  const ConstIterator operator--(int) {
-    const ConstIterator helper = *this;
-    --(*this);
-    return helper;
-  }
-  friend bool operator==(const ConstIterator& first, const ConstIterator& second) {
-    return first.ptr_ == second.ptr_;
-  }
-  friend bool operator!=(const ConstIterator& first, const ConstIterator& second) {
-    return first.ptr_ != second.ptr_;
-  }
-  friend bool operator>(const ConstIterator& first, const ConstIterator& second) {
-    return first.ptr_ > second.ptr_;
-  }
-  friend bool operator<(const ConstIterator& first, const ConstIterator& second) {
-    return first.ptr_ < second.ptr_;
-  }
-  friend bool operator>=(const ConstIterator& first, const ConstIterator& second) {
-    return first.ptr_ >= second.ptr_;
-  }
-  friend bool operator<=(const ConstIterator& first, const ConstIterator& second) {
-    return first.ptr_ <= second.ptr_;
-  }
-  friend difference_type operator-(const ConstIterator& first, const ConstIterator& second) {
-    return (first.ptr_ - second.ptr_);
-  }
-  friend ConstIterator operator+(const ConstIterator& iterator, const int64_t& value) {
-    Iterator result = iterator;
-    result.ptr_ += value;
-    return result;
+template <typename T, size_t kIndex>
+class CompressedMember<T, kIndex, false> {
+public:
+  CompressedMember() = default;
+  explicit CompressedMember(const T& value) : value_(value) {
   }
-  friend ConstIterator operator-(const ConstIterator& iterator, const int64_t& value) {
-    Iterator result = iterator;
-    result.ptr_ -= value;
-    return result;
+  explicit CompressedMember(T&& value) : value_(std::move(value)) {
   }
-  ConstIterator &operator+=(const int64_t& value) {
-    ptr_ += value;
-    return *this;
+
+  T& Get() {
+    return value_;
   }
-  ConstIterator &operator-=(const int64_t& value) {
-    ptr_ -= value;
-    return *this;
+  const T& Get() const {
+    return value_;
   }
 
- private:
-  pointer ptr_;
+private:
+  T value_;
 };
+}  // namespace vector_detail
+
+template <typename T, typename Allocator = std::allocator<T>, typename GrowthPolicy = DoublingGrowth,
+          typename StatsHook = NoVectorStats>
+class Vector : private vector_detail::CompressedMember<Allocator, 0>,
+               private vector_detail::CompressedMember<StatsHook, 1> {
+  // Аллокатор и хук статистики обычно пустые и хранятся базами, не увеличивая размер вектора
+  using AllocatorMember = vector_detail::CompressedMember<Allocator, 0>;
+  using StatsMember = vector_detail::CompressedMember<StatsHook, 1>;
 
-template <typename T>
-class Vector {
 public:
   using ValueType = T;
+  using AllocatorType = Allocator;
   using Pointer = T*;
   using ConstPointer = const T*;
   using Reference = T&;
   using ConstReference = const T&;
   using SizeType = size_t;
-  using Iterator = Iterator<T>;
-  using ConstIterator = ConstIterator<T>;
+  using Iterator = ::Iterator<T>;
+  using ConstIterator = ::ConstIterator<T>;
   using ReverseIterator = std::reverse_iterator<Iterator>;
   using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
 
   Vector();
+  explicit Vector(const Allocator& alloc);
   Vector(const Vector&);
   Vector(Vector&&) noexcept;
 
-  explicit Vector(SizeType size);
-  explicit Vector(SizeType size, T value);
+  explicit Vector(SizeType size, const Allocator& alloc = Allocator());
+  explicit Vector(SizeType size, T value, const Allocator& alloc = Allocator());
 
-  template <class Iterator, class =
+  template <class InputIterator, class =
   std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename
-  std::iterator_traits<Iterator>::iterator_category>>>
-  Vector(Iterator first, Iterator last) : capacity_(std::distance(first, last)), size_(std::distance(first, last)) {
-    if (size_ <= 0) {
-      arr_ = nullptr;
-    } else {
-      arr_ = new ValueType[size_];
-      try {
-        std::copy(first, last, arr_);
-      } catch (...) {
-        delete[] arr_;
-        throw;
-      }
+  std::iterator_traits<InputIterator>::iterator_category>>>
+  Vector(InputIterator first, InputIterator last, const Allocator& alloc = Allocator())
+      : AllocatorMember(alloc), capacity_(std::distance(first, last)), size_(0), arr_(Allocate(capacity_)) {
+    try {
+      std::uninitialized_copy(first, last, arr_);
+    } catch (...) {
+      Deallocate(arr_, capacity_);
+      throw;
     }
+    size_ = capacity_;
   }
 
-  Vector(std::initializer_list<T> list);
+  Vector(std::initializer_list<T> list, const Allocator& alloc = Allocator());
 
   [[nodiscard]] SizeType Size() const;
   [[nodiscard]] SizeType Capacity() const;
   [[nodiscard]] bool Empty() const;
 
   Vector& operator=(const Vector&);
-  Vector& operator=(Vector&&) noexcept;
+  Vector& operator=(Vector&&) noexcept(
+      std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value ||
+      std::allocator_traits<Allocator>::is_always_equal::value);
+
+  AllocatorType GetAllocator() const;
+  const StatsHook& GetStats() const;
 
   ConstReference operator[](SizeType ind) const;
   Reference operator[](SizeType ind);
@@ -223,6 +138,8 @@ public:
   Pointer Data();
   ConstPointer Data() const;
 
+  // Аллокаторы обмениваются только при propagate_on_container_swap; если они разные и остаются на месте,
+  // элементы переносятся в память аллокатора другого вектора
   void Swap(Vector&);
   void Resize(SizeType new_size);
   void Resize(SizeType new_size, ValueType value);
@@ -234,6 +151,29 @@ public:
   void PushBack(ValueType&&);
   void PopBack();
 
+  template <class... Args>
+  Reference EmplaceBack(Args&&... args);
+  template <class... Args>
+  Iterator Emplace(ConstIterator pos, Args&&... args);
+
+  // Диапазонные операции выделяют память не больше одного раза. Диапазон не должен указывать в этот же вектор
+  template <class ForwardIterator, class =
+  std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename
+  std::iterator_traits<ForwardIterator>::iterator_category>>>
+  void Append(ForwardIterator first, ForwardIterator last);
+  template <class ForwardIterator, class =
+  std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename
+  std::iterator_traits<ForwardIterator>::iterator_category>>>
+  Iterator Insert(ConstIterator pos, ForwardIterator first, ForwardIterator last);
+  template <class ForwardIterator, class =
+  std::enable_if_t<std::is_base_of_v<std::forward_iterator_tag, typename
+  std::iterator_traits<ForwardIterator>::iterator_category>>>
+  void Assign(ForwardIterator first, ForwardIterator last);
+  void AssignN(SizeType count, ValueType value);
+
+  Iterator Erase(ConstIterator pos);
+  Iterator Erase(ConstIterator first, ConstIterator last);
+
   ~Vector();
 
   bool operator<(const Vector& other) const;
@@ -262,158 +202,384 @@ public:
   ConstReverseIterator crend() const; // NOLINT
 
 private:
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+  // Память выделяется без конструирования, живые объекты только в [0, size_)
+  Pointer Allocate(SizeType count);
+  void Deallocate(Pointer ptr, SizeType count) noexcept;
+  // Переносит count элементов из from в to: memcpy для IsTriviallyRelocatable, иначе перемещение
+  // (если оно не бросает) или копирование. Старые объекты затем разрушает DestroyRelocated
+  static void UninitializedRelocate(Pointer from, SizeType count, Pointer to);
+  static void DestroyRelocated(Pointer from, SizeType count) noexcept;
+
+  // Со стандартным аллокатором буфер таких типов живет в malloc, чтобы рост мог расширять его на месте через realloc
+  static constexpr bool kUseRealloc = IsTriviallyRelocatable<T>::value &&
+      alignof(T) <= alignof(std::max_align_t) && std::is_same_v<Allocator, std::allocator<T>>;
+
+  void Reallocate(SizeType new_cap);
+  SizeType NextCapacity() const;
+  // Вместимость для роста до required элементов за одно выделение
+  SizeType CapacityFor(SizeType required) const;
+  void RecordReallocation(SizeType new_cap);
+
+  // Итераторы знают о смене буфера только в режиме VECTOR_CHECKED_ITERATORS
+  Iterator MakeIterator(Pointer ptr);
+  ConstIterator MakeConstIterator(ConstPointer ptr) const;
+  void Invalidate();
+  // Обменивает только буферы, аллокаторы остаются на месте
+  void SwapBuffers(Vector&) noexcept;
+
+  Allocator& Alloc();
+  const Allocator& Alloc() const;
+  StatsHook& Stats();
+  const StatsHook& Stats() const;
+
   SizeType capacity_;
   SizeType size_;
   Pointer arr_;
+#if VECTOR_CHECKED_ITERATORS
+  SizeType generation_ = 0;
+#endif
 };
 
-// Конструкторы
-template <typename T>  Vector<T>::Vector() : capacity_(0), size_(0), arr_(nullptr){
+// Работа с памятью
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Pointer Vector<T, Allocator, GrowthPolicy, StatsHook>::Allocate(SizeType count) {
+  if (count == 0) {
+    return nullptr;
+  }
+  if (count > AllocTraits::max_size(Alloc())) {
+    throw std::length_error("Vector is too long");
+  }
+  if constexpr (kUseRealloc) {
+    auto ptr = static_cast<Pointer>(std::malloc(count * sizeof(T)));
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+    return ptr;
+  } else {
+    return AllocTraits::allocate(Alloc(), count);
+  }
 }
 
-template <typename T>  Vector<T>::Vector(const Vector& v) : capacity_(v.capacity_), size_(v.size_) {
-  if (size_ <= 0) {
-    arr_ = nullptr;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Deallocate(Pointer ptr, SizeType count) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  if constexpr (kUseRealloc) {
+    std::free(ptr);
   } else {
-    arr_ = new ValueType[size_];
-    try {
-      std::copy(v.arr_, v.arr_ + size_, arr_);
-    } catch (...) {
-      delete[] arr_;
-      throw;
+    AllocTraits::deallocate(Alloc(), ptr, count);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::UninitializedRelocate(Pointer from, SizeType count, Pointer to) {
+  if constexpr (IsTriviallyRelocatable<T>::value) {
+    if (count != 0) {
+      std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+    }
+  } else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+    std::uninitialized_move_n(from, count, to);
+  } else {
+    std::uninitialized_copy_n(from, count, to);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::DestroyRelocated(Pointer from, SizeType count) noexcept {
+  if constexpr (!IsTriviallyRelocatable<T>::value) {
+    std::destroy_n(from, count);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Reallocate(SizeType new_cap) {
+  if constexpr (kUseRealloc) {
+    if (new_cap > AllocTraits::max_size(Alloc())) {
+      throw std::length_error("Vector is too long");
     }
+    auto new_arr = static_cast<Pointer>(std::realloc(static_cast<void*>(arr_), new_cap * sizeof(T)));
+    if (new_arr == nullptr) {
+      throw std::bad_alloc();
+    }
+    RecordReallocation(new_cap);
+    arr_ = new_arr;
+    Invalidate();
+    capacity_ = new_cap;
+    return;
+  }
+  Pointer new_arr = Allocate(new_cap);
+  try {
+    UninitializedRelocate(arr_, size_, new_arr);
+  } catch (...) {
+    Deallocate(new_arr, new_cap);
+    throw;
+  }
+  DestroyRelocated(arr_, size_);
+  Deallocate(arr_, capacity_);
+  RecordReallocation(new_cap);
+  arr_ = new_arr;
+  Invalidate();
+  capacity_ = new_cap;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::SizeType Vector<T, Allocator, GrowthPolicy, StatsHook>::NextCapacity() const {
+  // Политика, вернувшая не больше capacity_, иначе привела бы к записи за конец буфера
+  return std::max<SizeType>(GrowthPolicy::Grow(capacity_, sizeof(T)), capacity_ + 1);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::SizeType Vector<T, Allocator, GrowthPolicy, StatsHook>::CapacityFor(SizeType required) const {
+  SizeType next = NextCapacity();
+  return next > required ? next : required;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Allocator& Vector<T, Allocator, GrowthPolicy, StatsHook>::Alloc() {
+  return AllocatorMember::Get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+const Allocator& Vector<T, Allocator, GrowthPolicy, StatsHook>::Alloc() const {
+  return AllocatorMember::Get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+StatsHook& Vector<T, Allocator, GrowthPolicy, StatsHook>::Stats() {
+  return StatsMember::Get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+const StatsHook& Vector<T, Allocator, GrowthPolicy, StatsHook>::Stats() const {
+  return StatsMember::Get();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::RecordReallocation(SizeType new_cap) {
+  Stats().OnReallocate(new_cap, size_ * sizeof(T));
+}
+
+// Конструкторы
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector() : capacity_(0), size_(0), arr_(nullptr){
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector(const Allocator& alloc)
+    : AllocatorMember(alloc), capacity_(0), size_(0), arr_(nullptr) {
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector(const Vector& v)
+    : AllocatorMember(AllocTraits::select_on_container_copy_construction(v.Alloc())), StatsMember(),
+      capacity_(v.capacity_), size_(0), arr_(Allocate(v.capacity_)) {
+  try {
+    std::uninitialized_copy_n(v.arr_, v.size_, arr_);
+  } catch (...) {
+    Deallocate(arr_, capacity_);
+    throw;
   }
+  size_ = v.size_;
 }
 
-template <typename T>  Vector<T>::Vector(Vector && v) noexcept : capacity_(v.capacity_), size_(v.size_), arr_(v.arr_) {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector(Vector && v) noexcept
+    : AllocatorMember(std::move(v.Alloc())), capacity_(v.capacity_), size_(v.size_), arr_(v.arr_) {
   v.arr_ = nullptr;
+  v.Invalidate();
   v.capacity_ = 0;
   v.size_ = 0;
 }
 
-template <typename T>  Vector<T>::Vector(SizeType size) : capacity_(size), size_(size), arr_(new ValueType[size]){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector(SizeType size, const Allocator& alloc)
+    : AllocatorMember(alloc), capacity_(size), size_(0), arr_(Allocate(size)) {
+  try {
+    std::uninitialized_value_construct_n(arr_, size);
+  } catch (...) {
+    Deallocate(arr_, capacity_);
+    throw;
+  }
+  size_ = size;
 }
 
-template <typename T>  Vector<T>::Vector(SizeType size, T value) : capacity_(size), size_(size) {
-  if (size <= 0) {
-    arr_ = nullptr;
-    size_ = 0;
-  } else {
-    arr_ = new ValueType[size];
-    try {
-      for (SizeType i = 0; i < size; ++i) {
-        arr_[i] = value;
-      }
-    } catch (...) {
-      delete[] arr_;
-      throw;
-    }
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector(SizeType size, T value, const Allocator& alloc)
+    : AllocatorMember(alloc), capacity_(size), size_(0), arr_(Allocate(size)) {
+  try {
+    std::uninitialized_fill_n(arr_, size, value);
+  } catch (...) {
+    Deallocate(arr_, capacity_);
+    throw;
   }
+  size_ = size;
 }
 
-template <typename T>  Vector<T>::Vector(std::initializer_list<T> list) : capacity_(list.size()), size_(list.size()){
-  if (size_ <= 0) {
-    arr_ = nullptr;
-  } else {
-    arr_ = new ValueType[size_];
-    try {
-      std::copy(list.begin(), list.end(), arr_);
-    } catch (...) {
-      delete[] arr_;
-      throw;
-    }
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::Vector(std::initializer_list<T> list, const Allocator& alloc)
+    : AllocatorMember(alloc), capacity_(list.size()), size_(0), arr_(Allocate(list.size())) {
+  try {
+    std::uninitialized_copy(list.begin(), list.end(), arr_);
+  } catch (...) {
+    Deallocate(arr_, capacity_);
+    throw;
   }
+  size_ = list.size();
 }
 
 // Присваивание
-template <typename T> Vector<T> & Vector<T>::operator=(const Vector & other){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook> & Vector<T, Allocator, GrowthPolicy, StatsHook>::operator=(const Vector & other){
   if (this != &other) {
-    delete[] arr_;
-    arr_ = nullptr;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    if (size_ != 0) {
-      arr_ = new T[other.size_];
+    Vector copy(AllocTraits::propagate_on_container_copy_assignment::value ? other.Alloc() : Alloc());
+    copy.Reserve(other.capacity_);
+    std::uninitialized_copy_n(other.arr_, other.size_, copy.arr_);
+    copy.size_ = other.size_;
+    SwapBuffers(copy);
+    if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+      std::swap(Alloc(), copy.Alloc());
     }
-    std::copy_n(other.Data(), size_, arr_);
   }
   return *this;
 }
 
-template <typename T> Vector<T> & Vector<T>::operator=(Vector &&other) noexcept{
-  if (this != &other) {
-    delete[] arr_;
-    size_ = other.size_;
-    capacity_ = other.capacity_;
-    arr_ = other.arr_;
-    other.size_ = 0;
-    other.capacity_ = 0;
-    other.arr_ = nullptr;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook> & Vector<T, Allocator, GrowthPolicy, StatsHook>::operator=(Vector &&other) noexcept(
+    AllocTraits::propagate_on_container_move_assignment::value || AllocTraits::is_always_equal::value) {
+  if (this == &other) {
+    return *this;
+  }
+  if constexpr (!AllocTraits::propagate_on_container_move_assignment::value &&
+                !AllocTraits::is_always_equal::value) {
+    // Чужую память забрать нельзя, элементы переносятся в память своего аллокатора
+    if (Alloc() != other.Alloc()) {
+      Vector copy(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()), Alloc());
+      SwapBuffers(copy);
+      return *this;
+    }
+  }
+  std::destroy_n(arr_, size_);
+  Deallocate(arr_, capacity_);
+  size_ = other.size_;
+  capacity_ = other.capacity_;
+  arr_ = other.arr_;
+  Invalidate();
+  other.size_ = 0;
+  other.capacity_ = 0;
+  other.arr_ = nullptr;
+  other.Invalidate();
+  if constexpr (AllocTraits::propagate_on_container_move_assignment::value) {
+    Alloc() = std::move(other.Alloc());
   }
   return *this;
 }
 
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::AllocatorType Vector<T, Allocator, GrowthPolicy, StatsHook>::GetAllocator() const {
+  return Alloc();
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+const StatsHook& Vector<T, Allocator, GrowthPolicy, StatsHook>::GetStats() const {
+  return Stats();
+}
+
 // Методы
-template <typename T> typename Vector<T>::SizeType Vector<T>::Size() const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::SizeType Vector<T, Allocator, GrowthPolicy, StatsHook>::Size() const{
   return size_;
 }
 
 
-template <typename T> typename Vector<T>::SizeType Vector<T>::Capacity() const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::SizeType Vector<T, Allocator, GrowthPolicy, StatsHook>::Capacity() const{
   return capacity_;
 }
 
-template <typename T>  bool Vector<T>::Empty() const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::Empty() const{
   return size_ == 0;
 }
 
-template <typename T>  typename Vector<T>::Reference Vector<T>::operator[](size_t ind){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Reference Vector<T, Allocator, GrowthPolicy, StatsHook>::operator[](size_t ind){
   return arr_[ind];
 }
 
-template <typename T> typename Vector<T>::ConstReference Vector<T>::operator[](SizeType ind) const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReference Vector<T, Allocator, GrowthPolicy, StatsHook>::operator[](SizeType ind) const{
   return arr_[ind];
 }
 
-template <typename T> typename Vector<T>::Reference Vector<T>::At(SizeType ind){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Reference Vector<T, Allocator, GrowthPolicy, StatsHook>::At(SizeType ind){
   if (ind >= size_) {
     throw std::out_of_range("Index out of range");
   }
   return arr_[ind];
 }
 
-template <typename T> typename Vector<T>::ConstReference  Vector<T>::At(SizeType ind) const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReference  Vector<T, Allocator, GrowthPolicy, StatsHook>::At(SizeType ind) const{
   if (ind >= size_) {
     throw std::out_of_range("Index out of range");
   }
   return arr_[ind];
 }
 
-template <typename T> typename Vector<T>::Reference Vector<T>::Front(){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Reference Vector<T, Allocator, GrowthPolicy, StatsHook>::Front(){
   return arr_[0];
 }
 
-template <typename T> typename Vector<T>::ConstReference Vector<T>::Front() const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReference Vector<T, Allocator, GrowthPolicy, StatsHook>::Front() const{
   return arr_[0];
 }
 
-template <typename T> typename Vector<T>::ConstReference Vector<T>::Back() const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReference Vector<T, Allocator, GrowthPolicy, StatsHook>::Back() const {
   return arr_[size_ - 1];
 }
 
-template <typename T> typename Vector<T>::Reference Vector<T>::Back() {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Reference Vector<T, Allocator, GrowthPolicy, StatsHook>::Back() {
   return arr_[size_ - 1];
 }
 
-template <typename T> typename Vector<T>::ConstPointer Vector<T>::Data() const{
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstPointer Vector<T, Allocator, GrowthPolicy, StatsHook>::Data() const{
   return arr_;
 }
 
-template <typename T> typename Vector<T>::Pointer Vector<T>::Data(){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Pointer Vector<T, Allocator, GrowthPolicy, StatsHook>::Data(){
   return arr_;
 }
 
-template <typename T> void Vector<T>::Swap(Vector &v){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Swap(Vector &v){
+  if constexpr (AllocTraits::propagate_on_container_swap::value) {
+    SwapBuffers(v);
+    std::swap(Alloc(), v.Alloc());
+  } else if constexpr (AllocTraits::is_always_equal::value) {
+    SwapBuffers(v);
+  } else if (Alloc() == v.Alloc()) {
+    SwapBuffers(v);
+  } else {
+    // Аллокаторы остаются на месте, поэтому элементы переносятся в память аллокатора другого вектора
+    Vector mine(std::make_move_iterator(begin()), std::make_move_iterator(end()), v.Alloc());
+    Vector theirs(std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()), Alloc());
+    SwapBuffers(theirs);
+    v.SwapBuffers(mine);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::SwapBuffers(Vector &v) noexcept {
   auto tmp_s = v.size_;
   auto tmp_c = v.capacity_;
   auto tmp_a = v.arr_;
@@ -423,196 +589,412 @@ template <typename T> void Vector<T>::Swap(Vector &v){
   arr_ = tmp_a;
   capacity_ = tmp_c;
   size_ = tmp_s;
+  Invalidate();
+  v.Invalidate();
 }
 
-template <typename T> void Vector<T>::Resize(SizeType new_size){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Resize(SizeType new_size){
   if (new_size > capacity_) {
-    auto new_arr = new ValueType[new_size];
-    try {
-      std::move(begin(), end(), new_arr);
-      capacity_ = new_size;
-      size_ = new_size;
-      delete[] arr_;
-      arr_ = std::move(new_arr);
-    } catch (...) {
-      delete[] new_arr;
-      throw;
-    }
+    Reallocate(new_size);
   }
-  if (new_size < capacity_) {
-    size_ = new_size;
+  if (new_size > size_) {
+    std::uninitialized_value_construct(arr_ + size_, arr_ + new_size);
+  } else {
+    std::destroy(arr_ + new_size, arr_ + size_);
   }
+  size_ = new_size;
 }
 
-template <typename T> void Vector<T>::Resize(SizeType new_size, ValueType value){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Resize(SizeType new_size, ValueType value){
   if (new_size > capacity_) {
-    auto new_arr = new ValueType[new_size];
-    try {
-      for (size_t i = 0; i < size_; ++i) {
-        new_arr[i] = arr_[i];
-      }
-      for (size_t i = size_; i < new_size; ++i) {
-        new_arr[i] = value;
-      }
-    } catch (...) {
-      delete[] new_arr;
-      throw;
-    }
-    T* tmp = arr_;
-    capacity_ = new_size;
-    arr_ = new_arr;
-    delete[] tmp;
+    Reallocate(new_size);
   }
-  if (new_size < capacity_ && new_size > size_) {
-    std::fill(begin() + size_, begin() + new_size, value);
+  if (new_size > size_) {
+    std::uninitialized_fill(arr_ + size_, arr_ + new_size, value);
+  } else {
+    std::destroy(arr_ + new_size, arr_ + size_);
   }
   size_ = new_size;
 }
 
-template <typename T> void Vector<T>::Reserve(SizeType new_cap){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Reserve(SizeType new_cap){
   if (new_cap > capacity_) {
-    auto new_arr = new ValueType[new_cap];
-    try {
-      std::move(begin(), end(), new_arr);
-      delete[] arr_;
-      arr_ = new_arr;
-      capacity_ = new_cap;
-    } catch (...) {
-      delete[] new_arr;
-      throw;
-    }
+    Reallocate(new_cap);
   }
 }
 
-template <typename T> void Vector<T>::ShrinkToFit(){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::ShrinkToFit(){
   if (size_ == capacity_) {
     return;
   }
   if (size_ != 0) {
-    auto new_arr = new ValueType[size_];
-    try {
-      std::move(begin(), end(), new_arr);
-      delete[] arr_;
-      arr_ = new_arr;
-      capacity_ = size_;
-    } catch (...) {
-      delete[] new_arr;
-      throw;
-    }
+    Reallocate(size_);
   } else {
-    capacity_ = 0;
-    delete[] arr_;
+    Deallocate(arr_, capacity_);
     arr_ = nullptr;
+    Invalidate();
+    capacity_ = 0;
   }
 }
 
-template <typename T> void Vector<T>::Clear(){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Clear(){
+  std::destroy_n(arr_, size_);
+  Deallocate(arr_, capacity_);
+  arr_ = nullptr;
+  Invalidate();
   size_ = 0;
   capacity_ = 0;
 }
 
-template <typename T> void Vector<T>::PushBack(ConstReference value){
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::PushBack(ConstReference value){
+  EmplaceBack(value);
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::PushBack(ValueType && value){
+  EmplaceBack(std::move(value));
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::PopBack(){
+  if (size_ > 0) {
+    --size_;
+    std::destroy_at(arr_ + size_);
+  }
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+template <class... Args>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Reference Vector<T, Allocator, GrowthPolicy, StatsHook>::EmplaceBack(Args&&... args) {
+  if (size_ < capacity_) {
+    ::new (static_cast<void*>(arr_ + size_)) T(std::forward<Args>(args)...);
+  } else if constexpr (kUseRealloc) {
+    // args могут ссылаться на старый буфер, поэтому до realloc элемент строится во временной памяти
+    alignas(T) unsigned char buffer[sizeof(T)];
+    auto value = ::new (static_cast<void*>(buffer)) T(std::forward<Args>(args)...);
+    try {
+      Reallocate(NextCapacity());
+    } catch (...) {
+      std::destroy_at(value);
+      throw;
+    }
+    std::memcpy(static_cast<void*>(arr_ + size_), static_cast<const void*>(value), sizeof(T));
+  } else {
+    SizeType new_cap = NextCapacity();
+    Pointer new_arr = Allocate(new_cap);
+    // Новый элемент строится первым: args могут ссылаться на элементы старого буфера
+    try {
+      ::new (static_cast<void*>(new_arr + size_)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
+    try {
+      UninitializedRelocate(arr_, size_, new_arr);
+    } catch (...) {
+      std::destroy_at(new_arr + size_);
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
+    DestroyRelocated(arr_, size_);
+    Deallocate(arr_, capacity_);
+    RecordReallocation(new_cap);
+    arr_ = new_arr;
+    Invalidate();
+    capacity_ = new_cap;
+  }
+  return arr_[size_++];
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+template <class... Args>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::Emplace(ConstIterator pos, Args&&... args) {
+  SizeType index = pos - cbegin();
+  if (index == size_) {
+    EmplaceBack(std::forward<Args>(args)...);
+    return begin() + index;
+  }
   if (size_ < capacity_) {
-    arr_[size_] = std::move(value);
-    size_ += 1;
+    T value(std::forward<Args>(args)...);
+    ::new (static_cast<void*>(arr_ + size_)) T(std::move(arr_[size_ - 1]));
+    ++size_;
+    std::move_backward(arr_ + index, arr_ + size_ - 2, arr_ + size_ - 1);
+    arr_[index] = std::move(value);
   } else {
-    SizeType new_size = capacity_ > 0 ? capacity_ * 2 : 1;
-    auto new_data = new T[new_size];
+    SizeType new_cap = NextCapacity();
+    Pointer new_arr = Allocate(new_cap);
+    try {
+      ::new (static_cast<void*>(new_arr + index)) T(std::forward<Args>(args)...);
+    } catch (...) {
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
     try {
-      for (size_t i = 0; i < size_; ++i) {
-        new_data[i] = arr_[i];
-      }
-      new_data[size_] = std::move(value);
+      UninitializedRelocate(arr_, index, new_arr);
     } catch (...) {
-      delete[] new_data;
+      std::destroy_at(new_arr + index);
+      Deallocate(new_arr, new_cap);
       throw;
     }
-    delete[] arr_;
-    arr_ = new_data;
+    try {
+      UninitializedRelocate(arr_ + index, size_ - index, new_arr + index + 1);
+    } catch (...) {
+      std::destroy_n(new_arr, index + 1);
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
+    DestroyRelocated(arr_, size_);
+    Deallocate(arr_, capacity_);
+    RecordReallocation(new_cap);
+    arr_ = new_arr;
+    Invalidate();
+    capacity_ = new_cap;
     ++size_;
-    capacity_ = new_size;
   }
+  return begin() + index;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+template <class ForwardIterator, class>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Append(ForwardIterator first, ForwardIterator last) {
+  SizeType count = std::distance(first, last);
+  if (size_ + count > capacity_) {
+    Reallocate(CapacityFor(size_ + count));
+  }
+  std::uninitialized_copy(first, last, arr_ + size_);
+  size_ += count;
 }
-template <typename T> void Vector<T>::PushBack(ValueType && value){
-  if (size_ >= capacity_) {
-    auto new_capacity = capacity_ == 0 ? 1 : 2 * capacity_;
-    auto new_arr = new T[new_capacity];
-    std::move(begin(), end(), new_arr);
-    delete[] arr_;
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+template <class ForwardIterator, class>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::Insert(ConstIterator pos, ForwardIterator first,
+                                                                     ForwardIterator last) {
+  SizeType index = pos - cbegin();
+  SizeType count = std::distance(first, last);
+  if (count == 0) {
+    return begin() + index;
+  }
+  if (size_ + count > capacity_) {
+    SizeType new_cap = CapacityFor(size_ + count);
+    Pointer new_arr = Allocate(new_cap);
+    try {
+      std::uninitialized_copy(first, last, new_arr + index);
+    } catch (...) {
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
+    try {
+      UninitializedRelocate(arr_, index, new_arr);
+    } catch (...) {
+      std::destroy_n(new_arr + index, count);
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
+    try {
+      UninitializedRelocate(arr_ + index, size_ - index, new_arr + index + count);
+    } catch (...) {
+      std::destroy_n(new_arr, index + count);
+      Deallocate(new_arr, new_cap);
+      throw;
+    }
+    DestroyRelocated(arr_, size_);
+    Deallocate(arr_, capacity_);
+    RecordReallocation(new_cap);
     arr_ = new_arr;
-    capacity_ = new_capacity;
+    Invalidate();
+    capacity_ = new_cap;
+    size_ += count;
+    return begin() + index;
+  }
+  // Хвост сдвигается на count позиций: часть уходит в неинициализированную память, остальное присваиванием
+  SizeType tail = size_ - index;
+  Pointer old_end = arr_ + size_;
+  if (tail > count) {
+    std::uninitialized_move(old_end - count, old_end, old_end);
+    size_ += count;
+    std::move_backward(arr_ + index, old_end - count, old_end);
+    std::copy(first, last, arr_ + index);
+  } else {
+    ForwardIterator middle = std::next(first, tail);
+    std::uninitialized_copy(middle, last, old_end);
+    size_ += count - tail;
+    std::uninitialized_move(arr_ + index, old_end, arr_ + index + count);
+    size_ += tail;
+    std::copy(first, middle, arr_ + index);
+  }
+  return begin() + index;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+template <class ForwardIterator, class>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Assign(ForwardIterator first, ForwardIterator last) {
+  SizeType count = std::distance(first, last);
+  if (count > capacity_) {
+    Vector copy(first, last, Alloc());
+    SwapBuffers(copy);
+    return;
   }
-  arr_[size_++] = std::move(value);
+  if (count > size_) {
+    ForwardIterator middle = std::next(first, size_);
+    std::copy(first, middle, arr_);
+    std::uninitialized_copy(middle, last, arr_ + size_);
+  } else {
+    std::copy(first, last, arr_);
+    std::destroy(arr_ + count, arr_ + size_);
+  }
+  size_ = count;
 }
 
-template <typename T> void Vector<T>::PopBack(){
-  if (size_ > 0) {
-    --size_;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::AssignN(SizeType count, ValueType value) {
+  if (count > capacity_) {
+    Vector copy(count, value, Alloc());
+    SwapBuffers(copy);
+    return;
+  }
+  if (count > size_) {
+    std::fill_n(arr_, size_, value);
+    std::uninitialized_fill(arr_ + size_, arr_ + count, value);
+  } else {
+    std::fill_n(arr_, count, value);
+    std::destroy(arr_ + count, arr_ + size_);
+  }
+  size_ = count;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::Erase(ConstIterator pos) {
+  SizeType index = pos - cbegin();
+  std::move(arr_ + index + 1, arr_ + size_, arr_ + index);
+  PopBack();
+  return begin() + index;
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::Erase(ConstIterator first, ConstIterator last) {
+  SizeType from = first - cbegin();
+  SizeType to = last - cbegin();
+  if (from != to) {
+    std::move(arr_ + to, arr_ + size_, arr_ + from);
+    std::destroy(arr_ + size_ - (to - from), arr_ + size_);
+    size_ -= to - from;
   }
+  return begin() + from;
 }
 
 // Итераторы
-template <typename T> typename Vector<T>::Iterator Vector<T>::begin() { // NOLINT
-  return Vector::Iterator(arr_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::MakeIterator(Pointer ptr) {
+#if VECTOR_CHECKED_ITERATORS
+  return Iterator(ptr, IteratorSource<T>{&arr_, &size_, &generation_});
+#else
+  return Iterator(ptr);
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstIterator Vector<T, Allocator, GrowthPolicy, StatsHook>::MakeConstIterator(ConstPointer ptr) const {
+#if VECTOR_CHECKED_ITERATORS
+  return ConstIterator(ptr, IteratorSource<T>{&arr_, &size_, &generation_});
+#else
+  return ConstIterator(ptr);
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+void Vector<T, Allocator, GrowthPolicy, StatsHook>::Invalidate() {
+#if VECTOR_CHECKED_ITERATORS
+  ++generation_;
+#endif
+}
+
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::begin() { // NOLINT
+  return MakeIterator(arr_);
 }
 
-template <typename T> typename Vector<T>::Iterator Vector<T>::end() {  // NOLINT
-  return Vector::Iterator(arr_ + size_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::Iterator Vector<T, Allocator, GrowthPolicy, StatsHook>::end() {  // NOLINT
+  return MakeIterator(arr_ + size_);
 }
 
-template <typename T> typename Vector<T>::ConstIterator Vector<T>:: begin() const {  // NOLINT
-  return Vector::ConstIterator(arr_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: begin() const {  // NOLINT
+  return MakeConstIterator(arr_);
 }
 
-template <typename T> typename Vector<T>::ConstIterator Vector<T>:: end() const {  // NOLINT
-  return Vector::ConstIterator(arr_ + size_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: end() const {  // NOLINT
+  return MakeConstIterator(arr_ + size_);
 }
-template <typename T> typename Vector<T>::ConstIterator Vector<T>:: cbegin() const {  // NOLINT
-  return Vector::ConstIterator(arr_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: cbegin() const {  // NOLINT
+  return MakeConstIterator(arr_);
 }
-template <typename T> typename Vector<T>::ConstIterator Vector<T>:: cend() const {  // NOLINT
-  return Vector::ConstIterator(arr_ + size_);
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: cend() const {  // NOLINT
+  return MakeConstIterator(arr_ + size_);
 }
-template <typename T> typename Vector<T>::ReverseIterator Vector<T>:: rbegin() {  // NOLINT
-  return std::make_reverse_iterator(Iterator(arr_ + size_));
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ReverseIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: rbegin() {  // NOLINT
+  return std::make_reverse_iterator(MakeIterator(arr_ + size_));
 }
-template <typename T> typename Vector<T>::ReverseIterator Vector<T>:: rend() {  // NOLINT
-  return std::make_reverse_iterator(Iterator(arr_));
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ReverseIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: rend() {  // NOLINT
+  return std::make_reverse_iterator(MakeIterator(arr_));
 }
-template <typename T> typename Vector<T>::ConstReverseIterator Vector<T>:: rbegin() const {  // NOLINT
-  return std::make_reverse_iterator(ConstIterator(arr_ + size_));
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReverseIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: rbegin() const {  // NOLINT
+  return std::make_reverse_iterator(MakeConstIterator(arr_ + size_));
 }
-template <typename T> typename Vector<T>::ConstReverseIterator Vector<T>:: rend() const {  // NOLINT
-  return std::make_reverse_iterator(ConstIterator(arr_));
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReverseIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: rend() const {  // NOLINT
+  return std::make_reverse_iterator(MakeConstIterator(arr_));
 }
-template <typename T> typename Vector<T>::ConstReverseIterator Vector<T>:: crbegin() const {  // NOLINT
-  return std::make_reverse_iterator(ConstIterator(arr_ + size_));
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReverseIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: crbegin() const {  // NOLINT
+  return std::make_reverse_iterator(MakeConstIterator(arr_ + size_));
 }
-template <typename T> typename Vector<T>::ConstReverseIterator Vector<T>:: crend() const {  // NOLINT
-  return std::make_reverse_iterator(ConstIterator(arr_));
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+typename Vector<T, Allocator, GrowthPolicy, StatsHook>::ConstReverseIterator Vector<T, Allocator, GrowthPolicy, StatsHook>:: crend() const {  // NOLINT
+  return std::make_reverse_iterator(MakeConstIterator(arr_));
 }
 
 // Сравнения
-template <typename T> bool Vector<T>::operator<(const Vector& other) const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::operator<(const Vector& other) const {
   return std::lexicographical_compare(arr_, arr_ + size_, other.Data(), other.Data() + other.Size());
 }
-template <typename T> bool Vector<T>::operator>(const Vector& other) const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::operator>(const Vector& other) const {
   return other < *this;
 }
-template <typename T> bool Vector<T>::operator>=(const Vector& other) const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::operator>=(const Vector& other) const {
   return !(*this < other);
 }
-template <typename T> bool Vector<T>::operator<=(const Vector& other) const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::operator<=(const Vector& other) const {
   return !(*this > other);
 }
-template <typename T> bool Vector<T>::operator==(const Vector& other) const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::operator==(const Vector& other) const {
   return size_ == other.Size() && std::equal(arr_, arr_ + size_, other.Data());
 }
-template <typename T> bool Vector<T>::operator!=(const Vector& other) const {
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+bool Vector<T, Allocator, GrowthPolicy, StatsHook>::operator!=(const Vector& other) const {
   return !(*this == other);
 }
 
-template <typename T>  Vector<T>::~Vector(){
-  delete [] arr_;
+template <typename T, typename Allocator, typename GrowthPolicy, typename StatsHook>
+Vector<T, Allocator, GrowthPolicy, StatsHook>::~Vector(){
+  std::destroy_n(arr_, size_);
+  Deallocate(arr_, capacity_);
 }
 #endif //VECTOR_H
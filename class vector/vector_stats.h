@@ -0,0 +1,79 @@
+#ifndef VECTOR_STATS_H
+#define VECTOR_STATS_H
+
+#include <atomic>
+#include <cstddef>
+
+struct VectorStats {
+  size_t reallocations = 0;
+  size_t bytes_moved = 0;
+  size_t peak_capacity = 0;
+};
+
+// Хуки статистики для Vector: OnReallocate(new_capacity, bytes_moved) вызывается при каждой смене буфера.
+// По умолчанию ничего не собирается
+struct NoVectorStats {
+  void OnReallocate(size_t, size_t) {
+  }
+};
+
+// Статистика отдельного экземпляра
+class InstanceVectorStats {
+ public:
+  void OnReallocate(size_t new_capacity, size_t bytes_moved);
+  VectorStats Get() const;
+
+ private:
+  VectorStats stats_;
+};
+
+// Общая статистика всех векторов с одним и тем же Tag, можно обновлять из разных потоков
+template <typename Tag>
+class TypeVectorStats {
+ public:
+  void OnReallocate(size_t new_capacity, size_t bytes_moved);
+  static VectorStats Get();
+  static void Reset();
+
+ private:
+  inline static std::atomic<size_t> reallocations_ = 0;
+  inline static std::atomic<size_t> bytes_moved_ = 0;
+  inline static std::atomic<size_t> peak_capacity_ = 0;
+};
+
+// Методы
+inline void InstanceVectorStats::OnReallocate(size_t new_capacity, size_t bytes_moved) {
+  ++stats_.reallocations;
+  stats_.bytes_moved += bytes_moved;
+  if (new_capacity > stats_.peak_capacity) {
+    stats_.peak_capacity = new_capacity;
+  }
+}
+
+inline VectorStats InstanceVectorStats::Get() const {
+  return stats_;
+}
+
+template <typename Tag> void TypeVectorStats<Tag>::OnReallocate(size_t new_capacity, size_t bytes_moved) {
+  reallocations_.fetch_add(1, std::memory_order_relaxed);
+  bytes_moved_.fetch_add(bytes_moved, std::memory_order_relaxed);
+  size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+  while (new_capacity > peak && !peak_capacity_.compare_exchange_weak(peak, new_capacity, std::memory_order_relaxed)) {
+  }
+}
+
+template <typename Tag> VectorStats TypeVectorStats<Tag>::Get() {
+  VectorStats stats;
+  stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+  stats.bytes_moved = bytes_moved_.load(std::memory_order_relaxed);
+  stats.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+template <typename Tag> void TypeVectorStats<Tag>::Reset() {
+  reallocations_.store(0, std::memory_order_relaxed);
+  bytes_moved_.store(0, std::memory_order_relaxed);
+  peak_capacity_.store(0, std::memory_order_relaxed);
+}
+
+#endif  // VECTOR_STATS_H